@@ -0,0 +1,29 @@
+/*
+ * MIDIUSB.h - Simulator Stand-In
+ * 
+ * Sent packets are logged with their simulated time; received packets come
+ * from "midi" lines in the trace.
+ */
+
+#ifndef MIDIUSB_H
+#define MIDIUSB_H
+
+#include <Arduino.h>
+
+typedef struct {
+  uint8_t header;
+  uint8_t byte1;
+  uint8_t byte2;
+  uint8_t byte3;
+} midiEventPacket_t;
+
+class MIDI_ {
+ public:
+  void sendMIDI(midiEventPacket_t event);
+  void flush();
+  midiEventPacket_t read();
+};
+
+extern MIDI_ MidiUSB;
+
+#endif // MIDIUSB_H
@@ -0,0 +1,38 @@
+/*
+ * Wire.h - Simulator Stand-In
+ * 
+ * Every byte costs the simulated time it takes on the wire at the
+ * configured clock (9 bit times). An SSD1306 answers at 0x3C and keeps
+ * what the firmware writes to it, see simPrintScreen(). MCP23017s answer
+ * at 0x20-0x27 with every input line released; any other address is not
+ * acknowledged.
+ */
+
+#ifndef WIRE_H
+#define WIRE_H
+
+#include <Arduino.h>
+
+class TwoWire : public Print {
+ public:
+  void begin() {}
+  void setClock(uint32_t clock);
+  void beginTransmission(uint8_t address);
+  uint8_t endTransmission(bool stop = true);
+  size_t write(uint8_t data) override;
+  size_t write(const uint8_t* data, size_t size) override;
+  uint8_t requestFrom(uint8_t address, uint8_t quantity);
+  int available();
+  int read();
+
+ private:
+  uint32_t clock = 100000;
+  uint8_t address = 0;
+  uint8_t buffer[32];   // Like the AVR Wire library, longer writes are cut off
+  uint8_t length = 0;
+  uint8_t received = 0;   // Bytes requestFrom() fetched and read() hasn't taken
+};
+
+extern TwoWire Wire;
+
+#endif // WIRE_H
@@ -0,0 +1,20 @@
+/*
+ * avr/eeprom.h - Simulator Stand-In
+ * 
+ * 1 KB of blank (0xFF) EEPROM. Each programmed byte keeps the EEPROM busy
+ * for 3.4 ms of simulated time, like the real part.
+ */
+
+#ifndef AVR_EEPROM_H
+#define AVR_EEPROM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+uint8_t eeprom_read_byte(const uint8_t* address);
+void eeprom_read_block(void* destination, const void* source, size_t size);
+void eeprom_write_byte(uint8_t* address, uint8_t value);
+void eeprom_update_byte(uint8_t* address, uint8_t value);
+bool eeprom_is_ready();
+
+#endif // AVR_EEPROM_H
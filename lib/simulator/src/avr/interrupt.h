@@ -0,0 +1,21 @@
+/*
+ * avr/interrupt.h - Simulator Stand-In
+ * 
+ * An ISR becomes a plain function the simulated clock calls.
+ */
+
+#ifndef AVR_INTERRUPT_H
+#define AVR_INTERRUPT_H
+
+#define TIMER1_COMPA_vect simTimer1CompareA
+#define PCINT0_vect simPinChange0
+
+#define ISR(vector) void vector()
+
+void simTimer1CompareA();
+void simPinChange0();
+
+#define sei() interrupts()
+#define cli() noInterrupts()
+
+#endif // AVR_INTERRUPT_H
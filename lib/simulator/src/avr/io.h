@@ -0,0 +1,58 @@
+/*
+ * avr/io.h - Simulator Stand-In
+ * 
+ * The ATmega32U4 registers the firmware touches. The port input registers
+ * follow the pin levels replayed from a trace; Timer1's compare interrupt
+ * is run by the simulated clock at the rate its registers select, and a
+ * trace edge on a port B pin enabled in PCMSK0 runs PCINT0's. SPI
+ * transfers take their time at the selected clock, but nothing is on the
+ * bus: every byte reads back as released lines.
+ */
+
+#ifndef AVR_IO_H
+#define AVR_IO_H
+
+#include <stdint.h>
+
+#define _BV(bit) (1 << (bit))
+
+// Port input registers
+extern volatile uint8_t PINB, PINC, PIND, PINE, PINF;
+
+// Timer1
+extern volatile uint8_t TCCR1A, TCCR1B, TIMSK1;
+extern volatile uint16_t TCNT1, OCR1A;
+
+#define WGM12 3
+#define CS12 2
+#define CS11 1
+#define CS10 0
+#define OCIE1A 1
+
+// Pin change interrupt 0 (port B)
+extern volatile uint8_t PCICR, PCIFR, PCMSK0;
+
+#define PCIE0 0
+#define PCIF0 0
+
+// SPI
+class SimSpiData {
+ public:
+  SimSpiData& operator=(uint8_t data);   // Shifts a byte out, see simulator.cpp
+  operator uint8_t() const { return 0xFF; }
+};
+
+extern SimSpiData SPDR;
+extern volatile uint8_t SPCR, SPSR, DDRB;
+
+#define SPIE 7
+#define SPE 6
+#define DORD 5
+#define MSTR 4
+#define SPIF 7
+#define SPI2X 0
+#define DDB2 2
+#define DDB1 1
+#define DDB0 0
+
+#endif // AVR_IO_H
@@ -0,0 +1,20 @@
+/*
+ * avr/sleep.h - Simulator Stand-In
+ * 
+ * sleep_cpu() moves the simulated clock to the next interrupt that would
+ * wake idle sleep: a Timer1 tick, a pin change on an enabled PCINT pin,
+ * USB traffic from the trace, or Timer0's overflow every 1024 us.
+ */
+
+#ifndef AVR_SLEEP_H
+#define AVR_SLEEP_H
+
+#define SLEEP_MODE_IDLE 0
+
+#define set_sleep_mode(mode)
+
+void sleep_enable();
+void sleep_disable();
+void sleep_cpu();
+
+#endif // AVR_SLEEP_H
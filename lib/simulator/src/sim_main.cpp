@@ -0,0 +1,80 @@
+/*
+ * sim_main.cpp - Simulator Command Line
+ * 
+ * Replays one trace and prints the MIDI stream:
+ *   .pio/build/native/program test/traces/bounce_press.trace
+ * With a golden file as second argument it also compares the events
+ * against it and exits non-zero on a mismatch or stuck note. --screen
+ * adds what the OLED shows at the end of the trace.
+ * 
+ * Left out of `pio test` builds, where Unity provides main().
+ */
+
+#ifndef PIO_UNIT_TESTING
+
+#include <string.h>
+#include <unistd.h>
+
+#include "simulator.h"
+
+int main(int argc, char** argv) {
+  const char* program = argv[0];
+  if (argc > 1 && strcmp(argv[1], "--screen") == 0) {
+    simShowScreen = true;
+    argv++;
+    argc--;
+  }
+
+  if (argc < 2 || argc > 3) {
+    fprintf(stderr, "usage: %s [--screen] <trace> [golden]\n", program);
+    return 2;
+  }
+
+  if (argc == 2) {
+    FILE* trace = fopen(argv[1], "r");
+    if (!trace) {
+      perror(argv[1]);
+      return 2;
+    }
+    return simReplay(trace, stdout, argv[1]) ? 0 : 2;
+  }
+
+  // Replay into a temporary file, then check it
+  char outputPath[] = "/tmp/midi-calc-sim-XXXXXX";
+  int fd = mkstemp(outputPath);
+  if (fd < 0) {
+    perror("mkstemp");
+    return 2;
+  }
+  close(fd);
+
+  SimResult result;
+  std::vector<std::string> golden;
+  if (!simRunTrace(argv[1], outputPath) || !simLoadResult(outputPath, result)) {
+    fprintf(stderr, "%s: replay failed\n", argv[1]);
+    return 2;
+  }
+  if (!simLoadGolden(argv[2], golden)) {
+    perror(argv[2]);
+    return 2;
+  }
+
+  FILE* output = fopen(outputPath, "r");
+  int c;
+  while ((c = fgetc(output)) != EOF) {
+    putchar(c);
+  }
+  fclose(output);
+  unlink(outputPath);
+
+  bool match = golden == result.events;
+  if (!match) {
+    fprintf(stderr, "%s: MIDI stream differs from %s\n", argv[1], argv[2]);
+  }
+  if (result.stuckNotes) {
+    fprintf(stderr, "%s: %u stuck note(s)\n", argv[1], result.stuckNotes);
+  }
+  return match && result.stuckNotes == 0 ? 0 : 1;
+}
+
+#endif // PIO_UNIT_TESTING
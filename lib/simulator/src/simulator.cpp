@@ -0,0 +1,771 @@
+/*
+ * simulator.cpp - Host-Side Firmware Simulator
+ * 
+ * Stand-in implementations and the trace replay engine, see simulator.h.
+ */
+
+#include <algorithm>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "simulator.h"
+
+#include <Arduino.h>
+#include <MIDIUSB.h>
+#include <Wire.h>
+#include <avr/eeprom.h>
+#include <avr/sleep.h>
+
+// The firmware entry points (src/main.cpp)
+void setup();
+void loop();
+
+const unsigned long simCallCost = 2;              // us per clock query
+const unsigned long simSettleTime = 100000;       // Replay past the last input
+const unsigned long simBounceGap = 5000;          // Edges closer than this are one burst
+const unsigned long simBurstExpiry = 30000;       // Bursts that caused no note by then never will
+const unsigned long simUsbEnumerationTime = 100000;
+const unsigned long simEepromWriteTime = 3400;    // Per programmed byte
+const unsigned long simTimer0Period = 1024;       // millis() overflow, wakes idle sleep too
+
+// === REGISTERS ===
+volatile uint8_t PINB = 0xFF, PINC = 0xFF, PIND = 0xFF, PINE = 0xFF, PINF = 0xFF;
+volatile uint8_t TCCR1A = 0, TCCR1B = 0, TIMSK1 = 0;
+volatile uint16_t TCNT1 = 0, OCR1A = 0;
+volatile uint8_t PCICR = 0, PCIFR = 0, PCMSK0 = 0;
+volatile uint8_t SPCR = 0, SPSR = 0, DDRB = 0;
+SimSpiData SPDR;
+volatile uint8_t simOutputPorts[5];
+
+Serial_ Serial;
+USBDevice_ USBDevice;
+MIDI_ MidiUSB;
+TwoWire Wire;
+
+// Arduino Leonardo pin -> port (0 = B ... 4 = F) and bit, pins 0-23
+const uint8_t simPinPort[24] = {2, 2, 2, 2, 2, 1, 2, 3, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 4, 4, 4, 4, 4, 4};
+const uint8_t simPinBit[24] = {2, 3, 1, 0, 4, 6, 7, 6, 4, 5, 6, 7, 6, 7, 3, 1, 2, 0, 7, 6, 5, 4, 1, 0};
+volatile uint8_t* const simPorts[5] = {&PINB, &PINC, &PIND, &PINE, &PINF};
+
+// === TRACE ===
+enum SimInputKind {
+  SIM_INPUT_PIN,
+  SIM_INPUT_MIDI,
+  SIM_INPUT_SERIAL
+};
+
+struct SimInput {
+  unsigned long time;
+  uint8_t kind;
+  uint8_t pin;
+  uint8_t level;
+  midiEventPacket_t packet;
+  size_t line;   // Into simSerialLines
+};
+
+std::vector<SimInput> simInputs;
+size_t simNextInput = 0;
+std::vector<midiEventPacket_t> simMidiIn;
+size_t simMidiInNext = 0;
+std::vector<std::string> simSerialLines;
+std::string simSerialIn;
+size_t simSerialInNext = 0;
+
+// === CLOCK AND INTERRUPTS ===
+unsigned long simNow = 0;
+unsigned long simNextTick = 0;
+bool simTimerRunning = false;
+bool simInterruptsEnabled = true;
+bool simInInterrupt = false;
+bool simTickPending = false;
+bool simPinChangePending = false;
+bool simWoken = false;   // An interrupt has run since sleep_enable()
+
+// Timer1 compare period in us, 0 while its interrupt is off
+unsigned long simTimerPeriod() {
+  static const unsigned long prescalers[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+  unsigned long prescaler = prescalers[TCCR1B & 0x07];
+  if (prescaler == 0 || !(TIMSK1 & _BV(OCIE1A))) {
+    return 0;
+  }
+  return (OCR1A + 1UL) * prescaler / 16;   // 16 MHz
+}
+
+// Runs the pending interrupts, Timer1 first as its vector comes first
+void simRunInterrupts() {
+  if (!simInterruptsEnabled || simInInterrupt) {
+    return;
+  }
+
+  while (simTickPending || simPinChangePending) {
+    simInInterrupt = true;
+    simInterruptsEnabled = false;
+    if (simTickPending) {
+      simTickPending = false;
+      simTimer1CompareA();
+    } else {
+      simPinChangePending = false;
+      simPinChange0();
+    }
+    simInterruptsEnabled = true;
+    simInInterrupt = false;
+    simWoken = true;
+  }
+}
+
+void simRunTick() {
+  simTickPending = true;
+  simRunInterrupts();
+}
+
+void simApplyInput(const SimInput& input) {
+  // Both arrive over USB, whose interrupt wakes idle sleep
+  if (input.kind == SIM_INPUT_MIDI) {
+    simMidiIn.push_back(input.packet);
+    simWoken = true;
+    return;
+  }
+  if (input.kind == SIM_INPUT_SERIAL) {
+    simSerialIn += simSerialLines[input.line];
+    simSerialIn += '\n';
+    simWoken = true;
+    return;
+  }
+
+  uint8_t pin = input.pin;
+  volatile uint8_t& port = *simPorts[simPinPort[pin]];
+  uint8_t before = port;
+  if (input.level) {
+    port |= 1 << simPinBit[pin];
+  } else {
+    port &= ~(1 << simPinBit[pin]);
+  }
+
+  if (&port == &PINB && (PCICR & _BV(PCIE0)) && (PCMSK0 & (before ^ port))) {
+    simPinChangePending = true;
+    simRunInterrupts();
+  }
+}
+
+// Moves the clock forward, applying trace inputs and timer ticks on the way
+void simAdvance(unsigned long duration) {
+  unsigned long target = simNow + duration;
+
+  for (;;) {
+    unsigned long period = simTimerPeriod();
+    if (period != 0 && !simTimerRunning) {
+      simNextTick = simNow + period;
+    }
+    simTimerRunning = period != 0;
+
+    bool tickDue = simTimerRunning && (long)(simNextTick - target) <= 0;
+    bool inputDue = simNextInput < simInputs.size() && (long)(simInputs[simNextInput].time - target) <= 0;
+    if (!tickDue && !inputDue) {
+      break;
+    }
+
+    if (inputDue && (!tickDue || (long)(simInputs[simNextInput].time - simNextTick) <= 0)) {
+      const SimInput& input = simInputs[simNextInput++];
+      if ((long)(input.time - simNow) > 0) {
+        simNow = input.time;
+      }
+      simApplyInput(input);
+    } else {
+      if ((long)(simNextTick - simNow) > 0) {
+        simNow = simNextTick;
+      }
+      simNextTick += period;
+      simRunTick();
+    }
+  }
+
+  // An interrupt that ran meanwhile may already have moved past the target
+  if ((long)(target - simNow) > 0) {
+    simNow = target;
+  }
+}
+
+unsigned long micros() {
+  simAdvance(simCallCost);
+  return simNow;
+}
+
+unsigned long millis() {
+  simAdvance(simCallCost);
+  return simNow / 1000;
+}
+
+void delay(unsigned long ms) {
+  simAdvance(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+  simAdvance(us);
+}
+
+void noInterrupts() {
+  simInterruptsEnabled = false;
+}
+
+void interrupts() {
+  if (simInInterrupt) {
+    return;
+  }
+  simInterruptsEnabled = true;
+  simRunInterrupts();
+}
+
+// === SLEEP ===
+void sleep_enable() {
+  simWoken = false;
+}
+
+void sleep_disable() {
+}
+
+// Sleeps from input to input and tick to tick until one of them wakes it
+void sleep_cpu() {
+  unsigned long timer0Overflow = simNow + simTimer0Period - simNow % simTimer0Period;
+
+  while (!simWoken) {
+    unsigned long next = timer0Overflow;
+    if (simTimerRunning && (long)(simNextTick - next) < 0) {
+      next = simNextTick;
+    }
+    if (simNextInput < simInputs.size() && (long)(simInputs[simNextInput].time - next) < 0) {
+      next = simInputs[simNextInput].time;
+    }
+
+    simAdvance((long)(next - simNow) > 0 ? next - simNow : 0);
+    if ((long)(simNow - timer0Overflow) >= 0) {
+      simWoken = true;
+    }
+  }
+}
+
+// === PINS ===
+void pinMode(uint8_t, uint8_t) {
+  // Every pin idles high (pull-ups); only the trace pulls them low
+}
+
+int digitalRead(uint8_t pin) {
+  if (pin >= 24) {
+    return HIGH;
+  }
+  return (*simPorts[simPinPort[pin]] >> simPinBit[pin]) & 1;
+}
+
+void digitalWrite(uint8_t, uint8_t) {
+}
+
+uint8_t digitalPinToPort(uint8_t pin) {
+  return pin < 24 ? simPinPort[pin] : 0;
+}
+
+uint8_t digitalPinToBitMask(uint8_t pin) {
+  return pin < 24 ? 1 << simPinBit[pin] : 0;
+}
+
+volatile uint8_t* portOutputRegister(uint8_t port) {
+  return &simOutputPorts[port];
+}
+
+// === SPI ===
+SimSpiData& SimSpiData::operator=(uint8_t) {
+  // 8 bits at 16 MHz / 4, 16, 64 or 128, twice as fast with SPI2X
+  static const unsigned long dividers[4] = {4, 16, 64, 128};
+  unsigned long divider = dividers[SPCR & 0x03] >> (SPSR & _BV(SPI2X) ? 1 : 0);
+  simAdvance(8 * divider / 16);
+  SPSR |= _BV(SPIF);
+  return *this;
+}
+
+long random(long howBig) {
+  return howBig > 0 ? rand() % howBig : 0;
+}
+
+long random(long howSmall, long howBig) {
+  return howSmall + random(howBig - howSmall);
+}
+
+size_t Serial_::write(uint8_t c) {
+  return fputc(c, stderr) == EOF ? 0 : 1;
+}
+
+int Serial_::available() {
+  return simSerialIn.size() - simSerialInNext;
+}
+
+int Serial_::read() {
+  if (simSerialInNext == simSerialIn.size()) {
+    return -1;
+  }
+  return (uint8_t)simSerialIn[simSerialInNext++];
+}
+
+bool USBDevice_::configured() {
+  return simNow >= simUsbEnumerationTime;
+}
+
+// === EEPROM ===
+uint8_t simEeprom[1024];
+unsigned long simEepromBusyUntil = 0;
+
+struct SimEepromInit {
+  SimEepromInit() { memset(simEeprom, 0xFF, sizeof(simEeprom)); }
+} simEepromInit;
+
+uint8_t eeprom_read_byte(const uint8_t* address) {
+  return simEeprom[(uintptr_t)address & 0x3FF];
+}
+
+void eeprom_read_block(void* destination, const void* source, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    ((uint8_t*)destination)[i] = simEeprom[((uintptr_t)source + i) & 0x3FF];
+  }
+}
+
+void eeprom_write_byte(uint8_t* address, uint8_t value) {
+  // Like avr-libc: wait for the previous write, then start this one
+  while (!eeprom_is_ready()) {
+    simAdvance(simCallCost);
+  }
+  simEeprom[(uintptr_t)address & 0x3FF] = value;
+  simEepromBusyUntil = simNow + simEepromWriteTime;
+}
+
+void eeprom_update_byte(uint8_t* address, uint8_t value) {
+  if (eeprom_read_byte(address) != value) {
+    eeprom_write_byte(address, value);
+  }
+}
+
+bool eeprom_is_ready() {
+  return (long)(simNow - simEepromBusyUntil) >= 0;
+}
+
+// === I2C AND DISPLAY ===
+const uint8_t simPanelAddress = 0x3C;
+const uint8_t simFirstExpanderAddress = 0x20;
+const uint8_t simLastExpanderAddress = 0x27;
+
+// SSD1306 display RAM and addressing state (horizontal addressing mode)
+uint8_t simPanelRam[4][128];
+uint8_t simPanelFirstPage = 0, simPanelLastPage = 3, simPanelPage = 0;
+uint8_t simPanelFirstColumn = 0, simPanelLastColumn = 127, simPanelColumn = 0;
+uint8_t simPanelCommand = 0;   // Command still taking arguments
+uint8_t simPanelArgs[2];
+uint8_t simPanelArgCount = 0, simPanelArgsWanted = 0;
+bool simShowScreen = false;
+
+// Argument bytes following each SSD1306 command this firmware uses
+uint8_t simPanelArgsFor(uint8_t command) {
+  switch (command) {
+    case 0x21: case 0x22:
+      return 2;
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+void simPanelRunCommand() {
+  if (simPanelCommand == 0x21) {
+    simPanelFirstColumn = simPanelColumn = simPanelArgs[0] & 0x7F;
+    simPanelLastColumn = simPanelArgs[1] & 0x7F;
+  } else if (simPanelCommand == 0x22) {
+    simPanelFirstPage = simPanelPage = simPanelArgs[0] & 0x03;
+    simPanelLastPage = simPanelArgs[1] & 0x03;
+  }
+}
+
+void simPanelReceive(const uint8_t* bytes, uint8_t length) {
+  if (length == 0) {
+    return;
+  }
+
+  if (bytes[0] == 0x40) {
+    for (uint8_t i = 1; i < length; i++) {
+      simPanelRam[simPanelPage][simPanelColumn] = bytes[i];
+      if (simPanelColumn++ == simPanelLastColumn) {
+        simPanelColumn = simPanelFirstColumn;
+        simPanelPage = simPanelPage == simPanelLastPage ? simPanelFirstPage : simPanelPage + 1;
+      }
+    }
+    return;
+  }
+
+  for (uint8_t i = 1; i < length; i++) {
+    if (simPanelArgsWanted > 0) {
+      simPanelArgs[simPanelArgCount++] = bytes[i];
+      simPanelArgsWanted--;
+    } else {
+      simPanelCommand = bytes[i];
+      simPanelArgCount = 0;
+      simPanelArgsWanted = simPanelArgsFor(bytes[i]);
+    }
+    if (simPanelArgsWanted == 0) {
+      simPanelRunCommand();
+    }
+  }
+}
+
+void simPrintScreen(FILE* output) {
+  fprintf(output, "# screen\n");
+  for (uint8_t y = 0; y < 32; y++) {
+    char row[129];
+    for (uint8_t x = 0; x < 128; x++) {
+      row[x] = (simPanelRam[y / 8][x] >> (y % 8)) & 1 ? '#' : '.';
+    }
+    row[128] = '\0';
+    fprintf(output, "# |%s|\n", row);
+  }
+}
+
+void TwoWire::setClock(uint32_t newClock) {
+  clock = newClock;
+}
+
+void TwoWire::beginTransmission(uint8_t newAddress) {
+  address = newAddress;
+  length = 0;
+  simAdvance(10 * 1000000UL / clock);   // Start condition and address byte
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  simAdvance(1 * 1000000UL / clock + 1);
+  if (address >= simFirstExpanderAddress && address <= simLastExpanderAddress) {
+    return 0;   // Register writes change nothing the firmware reads
+  }
+  if (address != simPanelAddress) {
+    return 2;   // Address not acknowledged
+  }
+  simPanelReceive(buffer, length);
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t fromAddress, uint8_t quantity) {
+  // (Repeated) start and address, the bytes, then stop
+  simAdvance((10 + quantity * 9 + 1) * 1000000UL / clock);
+  bool expander = fromAddress >= simFirstExpanderAddress && fromAddress <= simLastExpanderAddress;
+  received = expander ? min(quantity, sizeof(buffer)) : 0;
+  return received;
+}
+
+int TwoWire::available() {
+  return received;
+}
+
+int TwoWire::read() {
+  if (received == 0) {
+    return -1;
+  }
+  received--;
+  return 0xFF;   // Pulled-up inputs, nothing pressed
+}
+
+size_t TwoWire::write(uint8_t data) {
+  return write(&data, 1);
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t size) {
+  size = min(size, sizeof(buffer) - length);
+  memcpy(buffer + length, data, size);
+  length += size;
+  simAdvance(size * 9 * 1000000UL / clock);
+  return size;
+}
+
+// === MIDI ===
+struct SimMidiOut {
+  unsigned long time;
+  midiEventPacket_t packet;
+};
+
+std::vector<SimMidiOut> simMidiOut;
+
+void MIDI_::sendMIDI(midiEventPacket_t event) {
+  simMidiOut.push_back({simNow, event});
+}
+
+void MIDI_::flush() {
+  simAdvance(20);
+}
+
+midiEventPacket_t MIDI_::read() {
+  if (simMidiInNext < simMidiIn.size()) {
+    return simMidiIn[simMidiInNext++];
+  }
+  return {0, 0, 0, 0};
+}
+
+// === REPLAY ===
+bool simParseTrace(FILE* trace, unsigned long& endTime) {
+  char line[128];
+  bool ended = false;
+  unsigned long last = 0;
+
+  while (fgets(line, sizeof(line), trace)) {
+    char* comment = strchr(line, '#');
+    if (comment) {
+      *comment = '\0';
+    }
+
+    unsigned long time;
+    char kind[8];
+    unsigned values[4];
+    int fields = sscanf(line, "%lu %7s", &time, kind);
+    if (fields <= 0) {
+      continue;
+    }
+    if (fields != 2) {
+      return false;
+    }
+
+    SimInput input = {};
+    input.time = time;
+    const char* rest = strstr(line, kind) + strlen(kind);
+
+    if (strcmp(kind, "pin") == 0) {
+      if (sscanf(rest, "%u %u", &values[0], &values[1]) != 2 || values[0] >= 24) {
+        return false;
+      }
+      input.kind = SIM_INPUT_PIN;
+      input.pin = values[0];
+      input.level = values[1] != 0;
+    } else if (strcmp(kind, "midi") == 0) {
+      if (sscanf(rest, "%x %x %x %x", &values[0], &values[1], &values[2], &values[3]) != 4) {
+        return false;
+      }
+      input.kind = SIM_INPUT_MIDI;
+      input.packet = {(uint8_t)values[0], (uint8_t)values[1], (uint8_t)values[2], (uint8_t)values[3]};
+    } else if (strcmp(kind, "serial") == 0) {
+      std::string text = rest + strspn(rest, " \t");
+      text.erase(text.find_last_not_of(" \t\r\n") + 1);
+      input.kind = SIM_INPUT_SERIAL;
+      input.line = simSerialLines.size();
+      simSerialLines.push_back(text);
+    } else if (strcmp(kind, "end") == 0) {
+      endTime = time;
+      ended = true;
+      continue;
+    } else {
+      return false;
+    }
+
+    if (time < last) {
+      return false;   // Inputs must be in time order
+    }
+    last = time;
+    simInputs.push_back(input);
+  }
+
+  if (!ended) {
+    endTime = last + simSettleTime;
+  }
+  return true;
+}
+
+void simFormatEvent(const midiEventPacket_t& packet, char* text, size_t size) {
+  uint8_t status = packet.byte1 & 0xF0;
+  uint8_t channel = packet.byte1 & 0x0F;
+  uint8_t cin = packet.header & 0x0F;
+
+  if (cin == 0x9 && packet.byte3 > 0) {
+    snprintf(text, size, "on %u %u %u", channel, packet.byte2, packet.byte3);
+  } else if (cin == 0x8 || cin == 0x9) {
+    snprintf(text, size, "off %u %u %u", channel, packet.byte2, packet.byte3);
+  } else if (cin == 0xB && status == 0xB0) {
+    snprintf(text, size, "cc %u %u %u", channel, packet.byte2, packet.byte3);
+  } else {
+    snprintf(text, size, "raw %02x %02x %02x %02x", packet.header, packet.byte1, packet.byte2, packet.byte3);
+  }
+}
+
+unsigned long simPercentile(std::vector<unsigned long> values, unsigned percent) {
+  if (values.empty()) {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  return values[(values.size() - 1) * percent / 100];
+}
+
+void simPrintLatency(FILE* output, const char* name, const std::vector<unsigned long>& values) {
+  unsigned long total = 0;
+  for (unsigned long value : values) {
+    total += value;
+  }
+  fprintf(output, "# latency_%s n=%zu min=%lu mean=%lu p50=%lu p95=%lu max=%lu\n", name, values.size(),
+          simPercentile(values, 0), values.empty() ? 0 : total / values.size(),
+          simPercentile(values, 50), simPercentile(values, 95), simPercentile(values, 100));
+}
+
+bool simReplay(FILE* trace, FILE* output, const char* name) {
+  unsigned long endTime;
+  if (!simParseTrace(trace, endTime)) {
+    fprintf(stderr, "%s: malformed trace\n", name);
+    return false;
+  }
+
+  srand(1);
+  setup();
+  while ((long)(simNow - endTime) < 0) {
+    loop();
+  }
+
+  // Sounding notes per channel and note, to spot stuck notes and retriggers
+  static uint8_t sounding[16][128];
+  unsigned retriggers = 0;
+  std::vector<unsigned long> onLatency;
+  std::vector<unsigned long> offLatency;
+
+  fprintf(output, "# midi-calc simulator: %s\n", name);
+  fprintf(output, "# time_us latency_us event\n");
+
+  // Each note-on/off is matched to the oldest button bounce burst it can
+  // answer; bursts that produced no note (mode, sharp...) expire
+  size_t nextInput = 0;
+  std::vector<unsigned long> bursts;
+  unsigned long edgeTime[24];
+  bool edgeSeen[24] = {};
+
+  for (const SimMidiOut& out : simMidiOut) {
+    while (nextInput < simInputs.size() && (long)(simInputs[nextInput].time - out.time) <= 0) {
+      const SimInput& input = simInputs[nextInput++];
+      if (input.kind != SIM_INPUT_PIN) {
+        continue;
+      }
+      if (!edgeSeen[input.pin] || input.time - edgeTime[input.pin] > simBounceGap) {
+        bursts.push_back(input.time);
+      }
+      edgeSeen[input.pin] = true;
+      edgeTime[input.pin] = input.time;
+    }
+    while (!bursts.empty() && out.time - bursts.front() > simBurstExpiry) {
+      bursts.erase(bursts.begin());
+    }
+
+    char event[48];
+    simFormatEvent(out.packet, event, sizeof(event));
+    bool isOn = strncmp(event, "on ", 3) == 0;
+    bool isOff = strncmp(event, "off ", 4) == 0;
+
+    if ((isOn || isOff) && !bursts.empty()) {
+      unsigned long latency = out.time - bursts.front();
+      bursts.erase(bursts.begin());
+      (isOn ? onLatency : offLatency).push_back(latency);
+      fprintf(output, "%lu %lu %s\n", out.time, latency, event);
+    } else {
+      fprintf(output, "%lu - %s\n", out.time, event);
+    }
+
+    uint8_t channel = out.packet.byte1 & 0x0F;
+    uint8_t note = out.packet.byte2 & 0x7F;
+    if (isOn) {
+      if (sounding[channel][note]) {
+        retriggers++;
+      }
+      sounding[channel][note] = 1;
+    } else if (isOff) {
+      sounding[channel][note] = 0;
+    }
+  }
+
+  unsigned stuck = 0;
+  for (uint8_t channel = 0; channel < 16; channel++) {
+    for (uint8_t note = 0; note < 128; note++) {
+      if (sounding[channel][note]) {
+        fprintf(output, "# stuck %u %u\n", channel, note);
+        stuck++;
+      }
+    }
+  }
+
+  fprintf(output, "# summary events=%zu stuck=%u retriggers=%u\n", simMidiOut.size(), stuck, retriggers);
+  simPrintLatency(output, "on", onLatency);
+  simPrintLatency(output, "off", offLatency);
+  if (simShowScreen) {
+    simPrintScreen(output);
+  }
+  return true;
+}
+
+bool simRunTrace(const char* tracePath, const char* outputPath) {
+  fflush(stdout);
+  fflush(stderr);
+
+  pid_t child = fork();
+  if (child < 0) {
+    return false;
+  }
+
+  if (child == 0) {
+    FILE* trace = fopen(tracePath, "r");
+    FILE* output = fopen(outputPath, "w");
+    bool ok = trace && output && simReplay(trace, output, tracePath);
+    if (output) {
+      fclose(output);
+    }
+    _exit(ok ? 0 : 1);
+  }
+
+  int status;
+  if (waitpid(child, &status, 0) != child) {
+    return false;
+  }
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// === RESULTS ===
+bool simLoadResult(const char* outputPath, SimResult& result) {
+  FILE* file = fopen(outputPath, "r");
+  if (!file) {
+    return false;
+  }
+
+  result = SimResult();
+  char line[160];
+  bool summary = false;
+
+  while (fgets(line, sizeof(line), file)) {
+    line[strcspn(line, "\r\n")] = '\0';
+    unsigned long dummy;
+
+    if (line[0] != '#') {
+      int offset = 0;
+      sscanf(line, "%*s %*s %n", &offset);
+      if (offset > 0) {
+        result.events.push_back(line + offset);
+      }
+    } else if (sscanf(line, "# summary events=%lu stuck=%u retriggers=%u", &dummy, &result.stuckNotes, &result.retriggers) == 3) {
+      summary = true;
+    } else if (strncmp(line, "# latency_on ", 13) == 0) {
+      sscanf(strstr(line, "p95="), "p95=%lu max=%lu", &result.noteOnLatencyP95, &result.noteOnLatencyMax);
+    } else if (strncmp(line, "# latency_off ", 14) == 0) {
+      sscanf(strstr(line, "max="), "max=%lu", &result.noteOffLatencyMax);
+    }
+  }
+
+  fclose(file);
+  return summary;
+}
+
+bool simLoadGolden(const char* goldenPath, std::vector<std::string>& events) {
+  FILE* file = fopen(goldenPath, "r");
+  if (!file) {
+    return false;
+  }
+
+  events.clear();
+  char line[96];
+  while (fgets(line, sizeof(line), file)) {
+    line[strcspn(line, "\r\n")] = '\0';
+    if (line[0] != '\0' && line[0] != '#') {
+      events.push_back(line);
+    }
+  }
+
+  fclose(file);
+  return true;
+}
@@ -0,0 +1,63 @@
+/*
+ * simulator.h - Host-Side Firmware Simulator
+ * 
+ * This library runs the unmodified firmware (src/) on Linux: the Arduino
+ * core, MIDIUSB and Wire are replaced by the stand-ins next to this file,
+ * and simulator.cpp drives them from a simulated clock. The OLED on the
+ * Wire bus is modelled too, so the final screen can be printed.
+ * 
+ * Time only moves when the firmware asks for it: every micros()/millis()
+ * call costs simCallCost, delays and I2C bytes cost what they would on the
+ * device, and Timer1's compare interrupt (the button scanner) runs whenever
+ * the clock passes its next tick, interrupting whatever code asked. Trace
+ * edges on port B pins run the pin-change interrupt, and idle sleep jumps
+ * the clock to the next interrupt that would wake it.
+ * 
+ * A trace is a text file of timestamped inputs, '#' starts a comment:
+ *   <time_us> pin <arduino pin> <level>            level 0 = pressed (to GND)
+ *   <time_us> midi <cin> <byte1> <byte2> <byte3>   USB-MIDI packet from the host, hex
+ *   <time_us> serial <line>                        command line typed on the serial port
+ *   <time_us> end                                  stop here (default: last input + 100 ms)
+ * Contact bounce is written out as the individual edges.
+ * 
+ * The replay writes every MIDI packet the firmware sends, one per line:
+ *   <time_us> <latency_us> <event>
+ * where <event> is "on|off <channel> <note> <velocity>", "cc ..." or
+ * "raw <cin> <byte1> <byte2> <byte3>". A note-on/off's latency is
+ * measured from the first edge of the oldest button bounce burst it has
+ * not been matched to yet ("-" if none). The summary lines
+ * at the end count stuck notes and retriggers and give the latency
+ * distribution. A golden file lists the expected <event> column only, so
+ * it does not change when timings move.
+ */
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Replay results as read back from a replay's output
+struct SimResult {
+  std::vector<std::string> events;   // <event> column of every line
+  unsigned stuckNotes;               // Still sounding when the trace ended
+  unsigned retriggers;               // Note-ons for a note already sounding
+  unsigned long noteOnLatencyMax;
+  unsigned long noteOnLatencyP95;
+  unsigned long noteOffLatencyMax;
+};
+
+// Replays a trace in this process (the firmware runs from reset, once)
+bool simReplay(FILE* trace, FILE* output, const char* name);
+
+// Replays a trace in a child process, so every trace starts from reset
+bool simRunTrace(const char* tracePath, const char* outputPath);
+
+// Appends the panel contents to the replay output as '#' comment lines
+extern bool simShowScreen;
+
+bool simLoadResult(const char* outputPath, SimResult& result);
+bool simLoadGolden(const char* goldenPath, std::vector<std::string>& events);
+
+#endif // SIMULATOR_H
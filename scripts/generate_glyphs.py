@@ -0,0 +1,174 @@
+"""
+generate_glyphs.py - Pre-rendered display text
+
+Renders every fixed string the mode screens show (headers, drum and
+arpeggiator pattern names, note names) with the firmware's 5x7 font into
+src/glyph_cache.h, as PROGMEM strips in the SSD1306's own layout: one byte
+per column holding 8 pixel rows, bit 0 on top. renderer.h blits a strip a
+whole byte per column instead of looking up and scaling each character.
+
+Note names are composed from a pitch class strip ("C#") and an octave strip
+("4"), so 23 strips cover all 128 MIDI notes.
+
+The names are read from src/modes.h and src/config.h, the font from
+src/font5x7.h. Runs as a PlatformIO pre-build script (the header is only
+rewritten when its contents change), or by hand:
+    python scripts/generate_glyphs.py
+"""
+
+import os
+import re
+
+try:
+    Import("env")   # Running as a PlatformIO pre-build script
+    ROOT = env.subst("$PROJECT_DIR")
+except NameError:
+    ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir)
+
+SRC = os.path.join(ROOT, "src")
+OUTPUT = os.path.join(SRC, "glyph_cache.h")
+
+# Size 1 labels: enum name -> text
+LABELS = [
+    ("GLYPH_KEYBOARD_MODE", "Keyboard Mode"),
+    ("GLYPH_SCALE_MODE", "Scale Mode"),
+    ("GLYPH_DRUM_MODE", "Drum Mode"),
+    ("GLYPH_ARP_MODE", "Arp Mode"),
+    ("GLYPH_CHORD_MODE", "Chord Mode"),
+    ("GLYPH_OCTAVE_LABEL", "Oct:"),
+    ("GLYPH_TRANSPOSE_LABEL", "T:"),
+    ("GLYPH_SYNC_LABEL", "Sync"),
+    ("GLYPH_MS_LABEL", "ms"),
+    ("GLYPH_STRUM_UP", "Strum up"),
+    ("GLYPH_STRUM_DOWN", "Strum down"),
+]
+
+# Size 2 messages shown where the note name goes, after "P1".."P<banks>"
+MESSAGES = [
+    ("GLYPH_SAVED", "Saved"),
+    ("GLYPH_LOOP_REC", "Rec"),
+    ("GLYPH_LOOP_DUB", "Dub"),
+    ("GLYPH_LOOP_PLAY", "Play"),
+    ("GLYPH_LOOP_STOP", "Stop"),
+    ("GLYPH_LOOP_UNDO", "Undo"),
+    ("GLYPH_LOOP_QUANTIZE", "Quant"),
+    ("GLYPH_LOOP_FREE", "Free"),
+    ("GLYPH_LOOP_FULL", "Full"),
+]
+
+
+def read(name):
+    with open(os.path.join(SRC, name)) as f:
+        return f.read()
+
+
+def read_font():
+    rows = re.findall(r"\{(0x[0-9A-Fa-f]{2}(?:, 0x[0-9A-Fa-f]{2}){4})\}", read("font5x7.h"))
+    if len(rows) != 95:
+        raise SystemExit("font5x7.h: expected 95 glyphs, found %d" % len(rows))
+    return [[int(value, 16) for value in row.split(", ")] for row in rows]
+
+
+def read_names(source, array):
+    match = re.search(r"\b%s\[\d+\]\[\d+\] PROGMEM = \{(.*?)\};" % array, read(source), re.S)
+    if not match:
+        raise SystemExit("%s: %s not found" % (source, array))
+    return re.findall(r'"([^"]*)"', match.group(1))
+
+
+def render(font, text, size):
+    """Columns of 8 * size rows, one cell (glyph + gap) per character."""
+    columns = []
+    for char in text:
+        glyph = font[ord(char) - 0x20] + [0]
+        for bits in glyph:
+            scaled = 0
+            for row in range(8):
+                if bits & (1 << row):
+                    scaled |= ((1 << size) - 1) << (row * size)
+            columns.extend([scaled] * size)
+    return columns
+
+
+def generate():
+    font = read_font()
+    strips = []   # (enum name or None, text, size)
+    strips += [(name, text, 1) for name, text in LABELS]
+
+    patterns = read_names("modes.h", "arpPatternNames")
+    drums = read_names("modes.h", "drumNames")
+    pitches = read_names("config.h", "noteNames")
+    octaves = [str(octave) for octave in range(-1, 10)]
+    banks = int(re.search(r"presetBankCount = (\d+);", read("config.h")).group(1))
+    presets = ["P%d" % (bank + 1) for bank in range(banks)]
+
+    strips += [("GLYPH_ARP_PATTERN_FIRST" if i == 0 else None, text, 1) for i, text in enumerate(patterns)]
+    strips += [("GLYPH_PITCH_FIRST" if i == 0 else None, text, 2) for i, text in enumerate(pitches)]
+    strips += [("GLYPH_OCTAVE_FIRST" if i == 0 else None, text, 2) for i, text in enumerate(octaves)]
+    strips += [("GLYPH_DRUM_FIRST" if i == 0 else None, text, 2) for i, text in enumerate(drums)]
+    strips += [("GLYPH_PRESET_FIRST" if i == 0 else None, text, 2) for i, text in enumerate(presets)]
+    strips += [(name, text, 2) for name, text in MESSAGES]
+
+    enum = []
+    table = []
+    data = []
+    offset = 0
+    for index, (name, text, size) in enumerate(strips):
+        if name:
+            enum.append("  %s = %d," % (name, index))
+        columns = render(font, text, size)
+        table.append("  {%d, %d, %d}, // %s" % (offset, len(columns), size, text))
+        rows = []
+        for band in range(size):
+            rows.append(", ".join("0x%02X" % ((column >> (8 * band)) & 0xFF) for column in columns))
+        data.append("  // %s\n  %s," % (text, ",\n  ".join(rows)))
+        offset += len(columns) * size
+    enum.append("  GLYPH_COUNT = %d" % len(strips))
+
+    return """/*
+ * glyph_cache.h - Pre-Rendered Display Text
+ * 
+ * Generated by scripts/generate_glyphs.py from font5x7.h, modes.h and
+ * config.h; do not edit. Each strip is <width> columns by <bands> pages
+ * (8 rows each), stored page by page in the SSD1306's column layout.
+ * drawGlyphs() (renderer.h) shows one.
+ */
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+enum GlyphId {
+%s
+};
+
+const uint8_t noGlyph = 0xFF;
+
+struct GlyphStrip {
+  uint16_t offset;   // Into glyphBitmaps
+  uint8_t width;
+  uint8_t bands;
+};
+
+const GlyphStrip glyphStrips[GLYPH_COUNT] PROGMEM = {
+%s
+};
+
+const uint8_t glyphBitmaps[%d] PROGMEM = {
+%s
+};
+
+#endif // GLYPH_CACHE_H
+""" % ("\n".join(enum), "\n".join(table), offset, "\n".join(data))
+
+
+def write_if_changed(contents):
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT) as f:
+            if f.read() == contents:
+                return
+    with open(OUTPUT, "w") as f:
+        f.write(contents)
+    print("Generated %s" % os.path.relpath(OUTPUT, ROOT))
+
+
+write_if_changed(generate())
@@ -0,0 +1,77 @@
+"""
+size_report.py - Build-time memory report
+
+PlatformIO post-build script. After linking it prints the static SRAM
+(.data + .bss) and flash (.text + .data) used by the firmware, how much each
+changed since the previous build, and the largest SRAM symbols.
+
+Static SRAM is the whole story: the firmware makes no heap allocations (the
+OLED is rendered page by page from a display list, see src/renderer.h, not
+from a malloc'd frame buffer).
+"""
+
+import json
+import os
+import subprocess
+
+Import("env")
+
+TOP_SYMBOLS = 12
+
+
+def section_sizes(size_tool, elf):
+    output = subprocess.check_output([size_tool, "-A", elf]).decode()
+    sizes = {}
+    for line in output.splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0].startswith(".") and parts[1].isdigit():
+            sizes[parts[0]] = int(parts[1])
+    return sizes
+
+
+def sram_symbols(nm_tool, elf):
+    output = subprocess.check_output([nm_tool, "--size-sort", "-S", "-C", elf]).decode()
+    symbols = []
+    for line in output.splitlines():
+        parts = line.split(None, 3)
+        if len(parts) == 4 and parts[2] in "bBdD":
+            symbols.append((int(parts[1], 16), parts[3]))
+    symbols.sort(reverse=True)
+    return symbols[:TOP_SYMBOLS]
+
+
+def delta(now, before):
+    if before is None:
+        return ""
+    return " (%+d since last build)" % (now - before)
+
+
+def size_report(source, target, env):
+    elf = str(target[0])
+    size_tool = env.subst("$SIZETOOL") or "avr-size"
+    nm_tool = size_tool[:-len("size")] + "nm"
+
+    sizes = section_sizes(size_tool, elf)
+    ram = sizes.get(".data", 0) + sizes.get(".bss", 0)
+    flash = sizes.get(".text", 0) + sizes.get(".data", 0)
+
+    history = os.path.join(env.subst("$BUILD_DIR"), "size_report.json")
+    previous = {}
+    if os.path.exists(history):
+        with open(history) as f:
+            previous = json.load(f)
+
+    print("")
+    print("Memory report")
+    print("  Static SRAM: %5d bytes%s" % (ram, delta(ram, previous.get("ram"))))
+    print("  Flash:       %5d bytes%s" % (flash, delta(flash, previous.get("flash"))))
+    print("  Largest SRAM symbols:")
+    for size, name in sram_symbols(nm_tool, elf):
+        print("    %5d  %s" % (size, name))
+    print("")
+
+    with open(history, "w") as f:
+        json.dump({"ram": ram, "flash": flash}, f)
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", size_report)
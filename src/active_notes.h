@@ -0,0 +1,140 @@
+/*
+ * active_notes.h - Active Note Tracking
+ * 
+ * This file tracks which notes are sounding on each output channel, so a
+ * note held by two buttons at once (E# and F with the sharp key, or two
+ * scale buttons that transpose onto the same pitch) only gets its note-off
+ * when the last of them is released.
+ * 
+ * Notes are tracked on the routing layers' channels (routing.h keeps them
+ * up to date) and on drumChannel; others pass straight through. Sounding
+ * notes live in a small table of {channel, note, holders}, so memory goes
+ * only to notes actually playing. The holder count is exact: a note is
+ * held at most once per button, arp step and loop voice on each layer,
+ * which the static_assert below keeps within 8 bits.
+ * 
+ * Should more than activeNoteCapacity distinct notes sound at once, the
+ * extra ones go out untracked: their release always sends a note-off, and
+ * stopAllPlayingNotes() adds All Notes Off (CC 123) on the tracked
+ * channels to catch them. Otherwise it sends exactly the note-offs that
+ * are needed, as one batched USB transfer.
+ */
+
+#ifndef ACTIVE_NOTES_H
+#define ACTIVE_NOTES_H
+
+// External variables needed for note tracking
+extern uint8_t buttonNotes[];
+
+// Channels with reference-counted notes, one slot per routing layer and
+// the drums last; others pass straight through
+uint8_t activeNoteChannels[activeNoteChannelCount] = {midiChannel, noChannel, noChannel, noChannel, drumChannel};
+
+static_assert(activeNoteChannelCount == 5, "activeNoteChannels above lists exactly 5 slots");
+
+struct ActiveNote {
+  uint8_t channel;
+  uint8_t note;
+  uint8_t refs;      // Holders, never 0 while in the table
+};
+
+static_assert((numButtons + 1 + looperMaxSounding) * routeLayerCount <= 255,
+              "A note's holders (buttons, arp, loop voices, per layer) must fit in refs");
+
+ActiveNote activeNotes[activeNoteCapacity];
+uint8_t activeNoteCount = 0;
+bool activeNotesOverflowed = false;   // Some note-on went out untracked
+
+// Function declarations
+void playNote(uint8_t channel, uint8_t note, uint8_t velocity);
+void releaseNote(uint8_t channel, uint8_t note);
+bool trackedChannel(uint8_t channel);
+int8_t findActiveNote(uint8_t channel, uint8_t note);
+void stopAllPlayingNotes();
+// Note: stopArpeggiator() is defined in arpeggiator.h
+void stopArpeggiator();
+// Note: silenceLooper() is defined in looper.h
+void silenceLooper();
+// Note: stopChords() is defined in chord_player.h
+void stopChords();
+
+bool trackedChannel(uint8_t channel) {
+  for (uint8_t slot = 0; slot < activeNoteChannelCount; slot++) {
+    if (activeNoteChannels[slot] == channel) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int8_t findActiveNote(uint8_t channel, uint8_t note) {
+  for (uint8_t i = 0; i < activeNoteCount; i++) {
+    if (activeNotes[i].note == note && activeNotes[i].channel == channel) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// Every press sends its note-on (a retrigger if the pitch already sounds)
+void playNote(uint8_t channel, uint8_t note, uint8_t velocity) {
+  if (trackedChannel(channel)) {
+    int8_t index = findActiveNote(channel, note);
+    if (index >= 0) {
+      activeNotes[index].refs++;
+    } else if (activeNoteCount < activeNoteCapacity) {
+      activeNotes[activeNoteCount++] = {channel, note, 1};
+    } else {
+      activeNotesOverflowed = true;
+    }
+  }
+  sendMidiNoteOn(channel, note, velocity);
+}
+
+// The note-off only goes out once no other holder is left
+void releaseNote(uint8_t channel, uint8_t note) {
+  if (trackedChannel(channel)) {
+    int8_t index = findActiveNote(channel, note);
+    if (index < 0) {
+      // Already silenced by stopAllPlayingNotes(), unless it went out untracked
+      if (!activeNotesOverflowed) {
+        return;
+      }
+    } else if (--activeNotes[index].refs > 0) {
+      return;
+    } else {
+      activeNotes[index] = activeNotes[--activeNoteCount];
+    }
+  }
+  sendMidiNoteOff(channel, note, 0);
+}
+
+// Mode or preset change: silence everything that is sounding, in one burst
+void stopAllPlayingNotes() {
+  stopArpeggiator();
+  silenceLooper();
+  stopChords();
+
+  for (uint8_t i = 0; i < numButtons; i++) {
+    buttonNotes[i] = noNote;
+  }
+
+  for (uint8_t i = 0; i < activeNoteCount; i++) {
+    sendMidiNoteOff(activeNotes[i].channel, activeNotes[i].note, 0);
+  }
+  activeNoteCount = 0;
+
+  if (activeNotesOverflowed) {
+    for (uint8_t slot = 0; slot < activeNoteChannelCount; slot++) {
+      if (activeNoteChannels[slot] != noChannel) {
+        midiEventPacket_t allNotesOff = {0x0B, (uint8_t)(0xB0 | activeNoteChannels[slot]), 123, 0};
+        queueMidiEvent(allNotesOff);
+      }
+    }
+    activeNotesOverflowed = false;
+  }
+
+  flushMidiQueue();
+}
+
+#endif // ACTIVE_NOTES_H
@@ -0,0 +1,371 @@
+/*
+ * arpeggiator.h - Clock-Synced Arpeggiator
+ * 
+ * This file plays the notes held in Arp mode one step at a time, using the
+ * Scales mode note mapping (calculateScaleMidiNote). Steps are sixteenth
+ * notes and follow, in order of preference:
+ *   - incoming MIDI clock (0xF8, 24 per beat) with start/continue/stop,
+ *     read by midi_input.h
+ *   - the internal tempo, counted in the 1 kHz Timer1 interrupt
+ * 
+ * The timer interrupt only schedules: it stamps each internal step and
+ * pushes it into a small lock-free queue. loop() sends due steps from the
+ * top of each pass, while it idles, and between display transfer chunks,
+ * so a step leaves well inside a millisecond even while the OLED updates.
+ * 
+ * Clock steps go through the same queue. Each clock that starts a step
+ * predicts when the next one is due from the smoothed clock period, and
+ * the interrupt queues that step once the time comes, without waiting for
+ * loop() to read the clock from USB. Only a clock that arrives before its
+ * prediction (the host sped up, or nothing was predicted yet) steps
+ * straight from the read.
+ * 
+ * The delay from a step being due (stamped by the timer, or predicted) to
+ * its note reaching USB is recorded as the "arp" telemetry stage (STATS).
+ */
+
+#ifndef ARPEGGIATOR_H
+#define ARPEGGIATOR_H
+
+// Function declarations
+void arpTimerTick();
+void queueArpStep(unsigned long due);
+void armArpClockStep(unsigned long due);
+void disarmArpClockStep();
+void serviceArpeggiator();
+void arpStep(unsigned long due);
+void handleArpNoteButton(int index, bool pressed);
+void handleArpPatternButton(bool pressed);
+void handleArpTempoButton(int index, bool pressed);
+void receiveMidiRealtime(uint8_t status);
+bool arpFollowingClock();
+void stopArpeggiator();
+uint8_t nextArpButton();
+
+// External variables needed for the arpeggiator
+extern unsigned long displayTimeout;
+
+// Held notes: bit n = note button n, plus the order they went down in
+uint8_t arpHeldMask = 0;
+uint8_t arpHeldOrder[numNoteButtons];
+uint8_t arpHeldCount = 0;
+
+uint8_t arpPattern = ARP_UP;
+uint16_t arpPosition = 0;          // Steps since the first note went down
+uint8_t arpBpm = arpDefaultBpm;    // 8-bit so the timer interrupt reads it atomically
+
+bool arpNoteSounding = false;
+uint8_t arpNote = 0;
+uint8_t arpButton = 0;             // Button the sounding note is routed by
+
+// Every pattern cycle (1-7 notes, up-down 2-12 steps) divides this, so the
+// position can wrap without a jump in the pattern
+const uint16_t arpPositionWrap = 840;
+
+// Internal tempo: the ISR adds bpm * steps per beat every millisecond and
+// steps each time the phase passes one minute's worth of milliseconds
+const uint16_t arpPhasePerStep = 60000;
+volatile bool arpInternalRunning = false;
+volatile uint16_t arpPhase = 0;
+
+// Scheduled steps, stamped with micros() when they fell due. The ISR only
+// writes arpStepTail and loop() only writes arpStepHead.
+unsigned long arpSteps[arpStepQueueSize];
+volatile uint8_t arpStepHead = 0;
+volatile uint8_t arpStepTail = 0;
+volatile uint16_t arpStepOverflows = 0;
+
+// MIDI clock: following while clocks keep arriving
+unsigned long arpLastClockTime = 0;
+unsigned long arpLastClockMicros = 0;
+unsigned long arpClockPeriod = 0;   // us between clocks, smoothed (also the looper's quantize grid)
+bool arpClockSeen = false;
+bool arpClockShown = false;     // What the display last showed
+bool arpTransportRunning = false;
+uint8_t arpClockCount = 0;
+
+// Predicted clock step: the ISR queues it at arpClockDue and sets
+// arpClockFired, so the clock that arrives later doesn't step again
+volatile unsigned long arpClockDue = 0;
+volatile bool arpClockArmed = false;
+volatile bool arpClockFired = false;
+
+// === SCHEDULER (INTERRUPT CONTEXT) ===
+void arpTimerTick() {
+  if (arpClockArmed && (long)(micros() - arpClockDue) >= 0) {
+    arpClockArmed = false;
+    arpClockFired = true;
+    queueArpStep(arpClockDue);
+  }
+
+  if (!arpInternalRunning) {
+    return;
+  }
+
+  uint16_t phase = arpPhase + arpBpm * arpStepsPerBeat;
+  if (phase < arpPhasePerStep) {
+    arpPhase = phase;
+    return;
+  }
+  arpPhase = phase - arpPhasePerStep;
+  queueArpStep(micros());
+}
+
+void queueArpStep(unsigned long due) {
+  uint8_t next = (arpStepTail + 1) & (arpStepQueueSize - 1);
+  if (next == arpStepHead) {
+    arpStepOverflows++;
+    return;
+  }
+  arpSteps[arpStepTail] = due;
+  arpStepTail = next;
+}
+
+// === STEP DISPATCH (LOOP CONTEXT) ===
+void serviceArpeggiator() {
+  // Hand over to the host clock while it runs; fall back when it goes quiet
+  if (arpClockSeen && millis() - arpLastClockTime > arpClockTimeout) {
+    arpClockSeen = false;
+    arpTransportRunning = false;
+    disarmArpClockStep();
+  }
+
+  // The tempo readout switches between the BPM and "Sync"
+  if (arpClockSeen != arpClockShown && currentMode == MODE_ARP) {
+    arpClockShown = arpClockSeen;
+    markDisplayDirty(REGION_STATUS);
+  }
+
+  bool internal = currentMode == MODE_ARP && arpHeldCount > 0 && !arpFollowingClock();
+  if (internal != arpInternalRunning) {
+    noInterrupts();
+    // Start the first step on the next tick
+    arpPhase = arpPhasePerStep - 1;
+    arpInternalRunning = internal;
+    interrupts();
+  }
+
+  while (arpStepHead != arpStepTail) {
+    unsigned long due = arpSteps[arpStepHead];
+    arpStepHead = (arpStepHead + 1) & (arpStepQueueSize - 1);
+    arpStep(due);
+  }
+}
+
+bool arpFollowingClock() {
+  return arpClockSeen;
+}
+
+// Releases the previous note and plays the next one in the pattern
+void arpStep(unsigned long due) {
+  if (arpNoteSounding) {
+    releaseRoutedNote(arpButton, arpNote);
+    arpNoteSounding = false;
+  }
+
+  if (currentMode == MODE_ARP && arpHeldCount > 0) {
+    arpButton = nextArpButton();
+    arpNote = calculateScaleMidiNote(arpButton);
+    playRoutedNote(arpButton, arpNote, velocity);
+    arpNoteSounding = true;
+    if (++arpPosition == arpPositionWrap) {
+      arpPosition = 0;
+    }
+
+    flushMidiQueue();
+    recordStage(STAGE_ARP, micros() - due);
+  } else {
+    flushMidiQueue();
+  }
+}
+
+// Picks the button for this step; up and down follow button order, which
+// is also pitch order in every scale
+uint8_t nextArpButton() {
+  uint8_t count = arpHeldCount;
+  uint8_t rank;
+
+  switch (arpPattern) {
+    case ARP_DOWN:
+      rank = count - 1 - arpPosition % count;
+      break;
+    case ARP_UP_DOWN:
+      if (count > 1) {
+        uint8_t period = 2 * count - 2;
+        rank = arpPosition % period;
+        if (rank >= count) {
+          rank = period - rank;
+        }
+      } else {
+        rank = 0;
+      }
+      break;
+    case ARP_RANDOM:
+      rank = random(count);
+      break;
+    case ARP_AS_PLAYED:
+      return arpHeldOrder[arpPosition % count];
+    default:
+      rank = arpPosition % count;
+      break;
+  }
+
+  // rank-th lowest held button
+  for (uint8_t i = 0; i < numNoteButtons; i++) {
+    if ((arpHeldMask & (1 << i)) && rank-- == 0) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+// === INCOMING MIDI CLOCK ===
+void receiveMidiRealtime(uint8_t status) {
+  const uint8_t clocksPerStep = midiClocksPerBeat / arpStepsPerBeat;
+
+  switch (status) {
+    case 0xF8: {  // Timing clock
+      unsigned long now = micros();
+      if (arpClockSeen) {
+        // A quarter of each new period, so USB read jitter barely moves the prediction
+        unsigned long period = now - arpLastClockMicros;
+        arpClockPeriod = arpClockPeriod == 0 ? period : (3 * arpClockPeriod + period) / 4;
+      }
+      arpLastClockMicros = now;
+      arpLastClockTime = millis();
+      arpClockSeen = true;
+      if (!arpTransportRunning) {
+        return;
+      }
+      if (arpClockCount == 0) {
+        noInterrupts();
+        bool fired = arpClockFired;
+        bool armed = arpClockArmed;
+        unsigned long due = arpClockDue;
+        arpClockArmed = false;
+        arpClockFired = false;
+        interrupts();
+
+        // Not queued by the timer yet: step now, late against the
+        // prediction if there was one that has passed
+        if (!fired) {
+          arpStep(armed && (long)(now - due) >= 0 ? due : now);
+        }
+        if (arpClockPeriod > 0) {
+          armArpClockStep(now + arpClockPeriod * clocksPerStep);
+        }
+      }
+      arpClockCount = (arpClockCount + 1) % clocksPerStep;
+      break;
+    }
+    case 0xFA:    // Start: from the top of the pattern
+      arpPosition = 0;
+      arpClockCount = 0;
+      arpTransportRunning = true;
+      // The first step comes with the next clock, due a period after the last
+      if (arpClockSeen && arpClockPeriod > 0) {
+        armArpClockStep(arpLastClockMicros + arpClockPeriod);
+      }
+      arpLastClockTime = millis();
+      arpClockSeen = true;
+      break;
+    case 0xFB:    // Continue
+      arpTransportRunning = true;
+      arpLastClockTime = millis();
+      arpClockSeen = true;
+      break;
+    case 0xFC:    // Stop
+      arpTransportRunning = false;
+      disarmArpClockStep();
+      if (arpNoteSounding) {
+        releaseRoutedNote(arpButton, arpNote);
+        arpNoteSounding = false;
+      }
+      break;
+  }
+}
+
+void armArpClockStep(unsigned long due) {
+  noInterrupts();
+  arpClockDue = due;
+  arpClockFired = false;
+  arpClockArmed = true;
+  interrupts();
+}
+
+// Also drops clock steps the timer queued that haven't gone out yet
+void disarmArpClockStep() {
+  noInterrupts();
+  arpClockArmed = false;
+  arpClockFired = false;
+  interrupts();
+  arpStepHead = arpStepTail;
+}
+
+// === BUTTONS (ARP MODE) ===
+void handleArpNoteButton(int index, bool pressed) {
+  if (pressed) {
+    if (arpHeldCount == 0) {
+      arpPosition = 0;
+    }
+    if (!(arpHeldMask & (1 << index))) {
+      arpHeldMask |= (1 << index);
+      arpHeldOrder[arpHeldCount++] = index;
+    }
+
+    showNoteName(calculateScaleMidiNote(index));
+    displayTimeout = millis() + DISPLAY_TIMEOUT;
+    return;
+  }
+
+  if (!(arpHeldMask & (1 << index))) {
+    return;
+  }
+  arpHeldMask &= ~(1 << index);
+
+  uint8_t kept = 0;
+  for (uint8_t i = 0; i < arpHeldCount; i++) {
+    if (arpHeldOrder[i] != index) {
+      arpHeldOrder[kept++] = arpHeldOrder[i];
+    }
+  }
+  arpHeldCount = kept;
+
+  // The last step keeps sounding until the next one, or until all are up
+  if (arpHeldCount == 0 && arpNoteSounding) {
+    releaseRoutedNote(arpButton, arpNote);
+    arpNoteSounding = false;
+  }
+}
+
+void handleArpPatternButton(bool pressed) {
+  if (pressed) {
+    arpPattern = (arpPattern + 1) % ARP_PATTERN_COUNT;
+    markDisplayDirty(REGION_DETAIL);
+  }
+}
+
+void handleArpTempoButton(int index, bool pressed) {
+  if (!pressed) {
+    return;
+  }
+
+  if (index == octaveDownButton) {
+    arpBpm = max(arpBpm - arpBpmStep, (int)arpMinBpm);
+  } else {
+    arpBpm = min(arpBpm + arpBpmStep, (int)arpMaxBpm);
+  }
+  markDisplayDirty(REGION_STATUS);
+}
+
+// Silences the arpeggiator and forgets held notes (mode or preset change)
+void stopArpeggiator() {
+  arpHeldMask = 0;
+  arpHeldCount = 0;
+  if (arpNoteSounding) {
+    releaseRoutedNote(arpButton, arpNote);
+    arpNoteSounding = false;
+  }
+}
+
+#endif // ARPEGGIATOR_H
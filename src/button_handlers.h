@@ -1,8 +1,9 @@
 /*
  * button_handlers.h - Button Handling Functions
  * 
- * This file contains all button handling functions including debouncing,
- * mode switching, and note triggering for different modes.
+ * This file contains all button handling functions including mode
+ * switching and note triggering for different modes. Each press/release
+ * event from the scanner (scanner.h) is dispatched once to its handler.
  */
 
 #ifndef BUTTON_HANDLERS_H
@@ -10,305 +11,273 @@
 
 // External variable declarations (defined in main file)
 extern ControllerMode currentMode;
-extern ScaleType currentScale;
-extern bool sharpState;
+extern uint8_t currentScale;
 extern int currentOctave;
 extern int octaveOffset;
 extern int semitoneOffset;
-extern String currentNote;
 extern unsigned long displayTimeout;
 extern int animationFrame;
-extern int playedMidiNotes[];
-extern bool noteIsPlaying[];
-extern unsigned long lastDebounceTime[];
-extern bool noteStates[];
-extern bool lastNoteStates[];
-extern bool lastSharpState;
-extern bool octaveDownState;
-extern bool lastOctaveDownState;
-extern bool octaveUpState;
-extern bool lastOctaveUpState;
-extern bool modeState;
-extern bool lastModeState;
+extern uint8_t buttonNotes[];
 
 // Function declarations
-void updateButtons();
-void handleNoteButton(int index);
-void handleDrumButton(int index, int pin);
-void handleOctaveButtons();
-void handleTransposeButtons();
-void handleModeButton();
-void handleSharpButton();
-void handleScaleButton();
-// Note: stopAllPlayingNotes() is defined in midi_functions.h
-
-// === NOTE BUTTON HANDLER ===
-void handleNoteButton(int index) {
-  int reading = digitalRead(notePins[index]);
-
-  if (reading != lastNoteStates[index]) {
-    lastDebounceTime[index] = millis();
-  }
-
-  if ((millis() - lastDebounceTime[index]) > debounceDelay) {
-    if (reading != noteStates[index]) {
-      noteStates[index] = reading;
-
-      if (noteStates[index] == LOW) { // Pressed
-        int note;
-        if (currentMode == MODE_STANDARD) {
-          note = calculateStandardMidiNote(index);
-        } else if (currentMode == MODE_SCALES) {
-          note = calculateScaleMidiNote(index);
-        } else { // MODE_DRUMS
-          note = calculateDrumMidiNote(index);
-        }
-        
-        playedMidiNotes[index] = note;
-        noteIsPlaying[index] = true;
-        
-        if (currentMode == MODE_DRUMS) {
-          sendMidiNoteOn(drumChannel, note, 127);
-          currentNote = drumNames[index % 10];
-        } else {
-          sendMidiNoteOn(midiChannel, note, 127);
-          currentNote = getScaleNoteName(note); // Use correct function name
-        }
-        
-        displayTimeout = millis() + DISPLAY_TIMEOUT;
-        updateDisplay();
-      } else { // Released
-        if (noteIsPlaying[index]) {
-          if (currentMode == MODE_DRUMS) {
-            sendMidiNoteOff(drumChannel, playedMidiNotes[index], 0);
-          } else {
-            sendMidiNoteOff(midiChannel, playedMidiNotes[index], 0);
-          }
-          noteIsPlaying[index] = false;
-        }
-      }
+void handleButtonEvent(const ButtonEvent& event);
+void handleNoteButton(int index, bool pressed);
+void handleDrumButton(int index, bool pressed);
+void handleKeyboardKey(int index, bool pressed);
+void handleOctaveButton(int index, bool pressed);
+void handleTransposeButton(int index, bool pressed);
+void handleModeButton(bool pressed);
+void handleFunctionButton(int index);
+void handleSharpButton(bool pressed);
+void handleScaleButton(bool pressed);
+bool sharpHeld();
+// Note: stopAllPlayingNotes() is defined in active_notes.h
+
+// Mode button state: held, and whether it was used as a function shift
+bool modeHeld = false;
+bool modeComboUsed = false;
+
+// Buttons whose press went to handleFunctionButton; their release is dropped
+ButtonMask functionButtons = 0;
+
+// === EVENT DISPATCH ===
+// Each press/release from the scanner is routed exactly once, to the
+// handler that owns that button in the current mode.
+void handleButtonEvent(const ButtonEvent& event) {
+  int index = event.button;
+
+  if (index == modeButton) {
+    // Mode button is always active
+    handleModeButton(event.pressed);
+  } else if (modeHeld && event.pressed) {
+    // Other buttons act as function keys while mode is held
+    functionButtons |= (ButtonMask)1 << index;
+    handleFunctionButton(index);
+  } else if (functionButtons & ((ButtonMask)1 << index)) {
+    // Its press was a function key, so the mode's handler never saw it
+    functionButtons &= ~((ButtonMask)1 << index);
+  } else if (index >= firstKeyboardButton) {
+    // Keys past the panel buttons play in every mode
+    handleKeyboardKey(index, event.pressed);
+  } else if (currentMode == MODE_DRUMS) {
+    // All 10 buttons play drums (7 main + sharp, octave down, octave up)
+    handleDrumButton(index, event.pressed);
+  } else if (currentMode == MODE_ARP) {
+    if (index < numNoteButtons) {
+      handleArpNoteButton(index, event.pressed);
+    } else if (index == sharpButton) {
+      handleArpPatternButton(event.pressed); // Sharp button becomes pattern selector
+    } else {
+      handleArpTempoButton(index, event.pressed); // Octave buttons become tempo
+    }
+  } else if (currentMode == MODE_CHORDS) {
+    if (index < numNoteButtons) {
+      handleChordButton(index, event.pressed);
+    } else if (index == sharpButton) {
+      handleStrumDirectionButton(event.pressed); // Sharp button flips the strum
+    } else {
+      handleStrumTimeButton(index, event.pressed); // Octave buttons set the strum time
+    }
+  } else if (index < numNoteButtons) {
+    handleNoteButton(index, event.pressed);
+  } else if (currentMode == MODE_STANDARD) {
+    if (index == sharpButton) {
+      handleSharpButton(event.pressed);
+    } else {
+      handleOctaveButton(index, event.pressed);
+    }
+  } else if (currentMode == MODE_SCALES) {
+    if (index == sharpButton) {
+      handleScaleButton(event.pressed); // Sharp button becomes scale selector
+    } else {
+      handleTransposeButton(index, event.pressed); // Octave buttons become transpose
     }
   }
-
-  lastNoteStates[index] = reading;
 }
 
-// === DRUM BUTTON HANDLER ===
-void handleDrumButton(int index, int pin) {
-  int reading = digitalRead(pin);
-  
-  // Use a separate state tracking for extra drum buttons
-  static bool extraDrumStates[3] = {HIGH, HIGH, HIGH};
-  static bool lastExtraDrumStates[3] = {HIGH, HIGH, HIGH};
-  
-  int extraIndex = index - numNoteButtons; // 0, 1, or 2 for the extra buttons
-  
-  if (reading != lastExtraDrumStates[extraIndex]) {
-    lastDebounceTime[index] = millis();
-  }
-
-  if ((millis() - lastDebounceTime[index]) > debounceDelay) {
-    if (reading != extraDrumStates[extraIndex]) {
-      extraDrumStates[extraIndex] = reading;
-
-      if (extraDrumStates[extraIndex] == LOW) {
-        int drumNote = calculateDrumMidiNote(index);
-        playedMidiNotes[index] = drumNote;
-        noteIsPlaying[index] = true;
-        sendMidiNoteOn(drumChannel, drumNote, 127);
-        currentNote = drumNames[index % 10];
-        displayTimeout = millis() + DISPLAY_TIMEOUT;
-        updateDisplay();
-      } else {
-        if (noteIsPlaying[index]) {
-          sendMidiNoteOff(drumChannel, playedMidiNotes[index], 0);
-          noteIsPlaying[index] = false;
-        }
-      }
+// === NOTE BUTTON HANDLER (STANDARD AND SCALE MODES) ===
+void handleNoteButton(int index, bool pressed) {
+  if (pressed) {
+    int note;
+    if (currentMode == MODE_STANDARD) {
+      note = calculateStandardMidiNote(index);
+    } else {
+      note = calculateScaleMidiNote(index);
     }
+    
+    buttonNotes[index] = note;
+    playRoutedNote(index, note, 127);
+    showNoteName(note);
+    displayTimeout = millis() + DISPLAY_TIMEOUT;
+    looperRecord(index, note, true, false);
+  } else if (buttonNotes[index] != noNote) {
+    // Another button may still hold the same pitch (E# and F, say)
+    releaseRoutedNote(index, buttonNotes[index]);
+    looperRecord(index, buttonNotes[index], false, false);
+    buttonNotes[index] = noNote;
   }
-
-  lastExtraDrumStates[extraIndex] = reading;
 }
 
-// === OCTAVE BUTTON HANDLERS (STANDARD MODE) ===
-void handleOctaveButtons() {
-  int downReading = digitalRead(octaveDownPin);
-  int upReading = digitalRead(octaveUpPin);
-
-  if (downReading != lastOctaveDownState) {
-    lastDebounceTime[numNoteButtons + 1] = millis();
-  }
-  if (upReading != lastOctaveUpState) {
-    lastDebounceTime[numNoteButtons + 2] = millis();
+// === DRUM BUTTON HANDLER ===
+void handleDrumButton(int index, bool pressed) {
+  if (pressed) {
+    int drumNote = calculateDrumMidiNote(index);
+    buttonNotes[index] = drumNote;
+    playNote(drumChannel, drumNote, 127);
+    showGlyphs(GLYPH_DRUM_FIRST + index % 10);
+    displayTimeout = millis() + DISPLAY_TIMEOUT;
+    looperRecord(index, drumNote, true, true);
+  } else if (buttonNotes[index] != noNote) {
+    releaseNote(drumChannel, buttonNotes[index]);
+    looperRecord(index, buttonNotes[index], false, true);
+    buttonNotes[index] = noNote;
   }
+}
 
-  if ((millis() - lastDebounceTime[numNoteButtons + 1]) > debounceDelay) {
-    if (downReading != octaveDownState) {
-      octaveDownState = downReading;
-      if (octaveDownState == LOW) {
-        octaveOffset = max(octaveOffset - 1, -3);
-        updateDisplay();
-      }
+// === KEYBOARD KEY HANDLER (EXPANDER BACKENDS) ===
+void handleKeyboardKey(int index, bool pressed) {
+  if (pressed) {
+    int note = calculateKeyboardMidiNote(index - firstKeyboardButton);
+    if (note == noNote) {
+      return;
     }
-  }
 
-  if ((millis() - lastDebounceTime[numNoteButtons + 2]) > debounceDelay) {
-    if (upReading != octaveUpState) {
-      octaveUpState = upReading;
-      if (octaveUpState == LOW) {
-        octaveOffset = min(octaveOffset + 1, 3);
-        updateDisplay();
-      }
+    buttonNotes[index] = note;
+    if (currentMode == MODE_DRUMS) {
+      playNote(drumChannel, note, 127);
+    } else {
+      playRoutedNote(index, note, 127);
+      showNoteName(note);
+      displayTimeout = millis() + DISPLAY_TIMEOUT;
+    }
+    looperRecord(index, note, true, currentMode == MODE_DRUMS);
+  } else if (buttonNotes[index] != noNote) {
+    // A mode change silences held keys, so the mode still says where it went
+    if (currentMode == MODE_DRUMS) {
+      releaseNote(drumChannel, buttonNotes[index]);
+    } else {
+      releaseRoutedNote(index, buttonNotes[index]);
     }
+    looperRecord(index, buttonNotes[index], false, currentMode == MODE_DRUMS);
+    buttonNotes[index] = noNote;
   }
-
-  lastOctaveDownState = downReading;
-  lastOctaveUpState = upReading;
 }
 
-// === TRANSPOSE BUTTON HANDLERS (SCALE MODE) ===
-void handleTransposeButtons() {
-  int downReading = digitalRead(octaveDownPin);
-  int upReading = digitalRead(octaveUpPin);
-
-  if (downReading != lastOctaveDownState) {
-    lastDebounceTime[numNoteButtons + 1] = millis();
-  }
-  if (upReading != lastOctaveUpState) {
-    lastDebounceTime[numNoteButtons + 2] = millis();
+// === OCTAVE BUTTON HANDLER (STANDARD MODE) ===
+void handleOctaveButton(int index, bool pressed) {
+  if (!pressed) {
+    return;
   }
 
-  if ((millis() - lastDebounceTime[numNoteButtons + 1]) > debounceDelay) {
-    if (downReading != octaveDownState) {
-      octaveDownState = downReading;
-      if (octaveDownState == LOW) {
-        semitoneOffset = max(semitoneOffset - 1, -24); // Down by semitone
-        updateDisplay();
-      }
-    }
+  if (index == octaveDownButton) {
+    octaveOffset = max(octaveOffset - 1, minOctaveOffset);
+  } else {
+    octaveOffset = min(octaveOffset + 1, maxOctaveOffset);
   }
+  markDisplayDirty(REGION_STATUS);
+}
 
-  if ((millis() - lastDebounceTime[numNoteButtons + 2]) > debounceDelay) {
-    if (upReading != octaveUpState) {
-      octaveUpState = upReading;
-      if (octaveUpState == LOW) {
-        semitoneOffset = min(semitoneOffset + 1, 24); // Up by semitone
-        updateDisplay();
-      }
-    }
+// === TRANSPOSE BUTTON HANDLER (SCALE MODE) ===
+void handleTransposeButton(int index, bool pressed) {
+  if (!pressed) {
+    return;
   }
 
-  lastOctaveDownState = downReading;
-  lastOctaveUpState = upReading;
+  if (index == octaveDownButton) {
+    semitoneOffset = max(semitoneOffset - 1, minSemitoneOffset); // Down by semitone
+  } else {
+    semitoneOffset = min(semitoneOffset + 1, maxSemitoneOffset); // Up by semitone
+  }
+  markDisplayDirty(REGION_STATUS);
 }
 
 // === SHARP BUTTON HANDLER (STANDARD MODE) ===
-void handleSharpButton() {
-  int reading = digitalRead(sharpPin);
-
-  if (reading != lastSharpState) {
-    lastDebounceTime[numNoteButtons + 4] = millis();
-  }
-
-  if ((millis() - lastDebounceTime[numNoteButtons + 4]) > debounceDelay) {
-    if (reading != sharpState) {
-      sharpState = reading;
-      updateDisplay();
-    }
-  }
+// Sharp applies to notes pressed while it is down; sharpHeld() reads that
+// from the button state, so this only redraws the note
+void handleSharpButton(bool pressed) {
+  markDisplayDirty(REGION_NOTE);
+}
 
-  lastSharpState = reading;
+// Read from the applied button state rather than tracked per handler: a
+// sharp held across a mode change is released in another mode's handler,
+// and must not stay down. A press that went to a mode combo doesn't count.
+bool sharpHeld() {
+  return (appliedButtons & ~functionButtons) & ((ButtonMask)1 << sharpButton);
 }
 
 // === SCALE BUTTON HANDLER (SCALE MODE) ===
-void handleScaleButton() {
-  int reading = digitalRead(sharpPin); // Reuse sharp button for scale selection
-
-  if (reading != lastSharpState) {
-    lastDebounceTime[numNoteButtons + 4] = millis();
-  }
-
-  if ((millis() - lastDebounceTime[numNoteButtons + 4]) > debounceDelay) {
-    if (reading != sharpState) {
-      sharpState = reading;
-      
-      if (sharpState == LOW) { // Button pressed
-        // Cycle through available scales
-        currentScale = (ScaleType)((currentScale + 1) % SCALE_COUNT);
-        updateDisplay();
-      }
-    }
+void handleScaleButton(bool pressed) {
+  if (pressed) {
+    // Cycle through available scales
+    currentScale = nextScale(currentScale);
+    markDisplayDirty(REGION_DETAIL);
   }
-
-  lastSharpState = reading;
 }
 
 // === MODE SWITCH BUTTON HANDLER ===
-void handleModeButton() {
-  int reading = digitalRead(modePin);
-
-  if (reading != lastModeState) {
-    lastDebounceTime[numNoteButtons + 3] = millis();
+// A tap cycles modes on release; if another button was pressed while it
+// was held, it acted as a function shift instead and the mode stays.
+void handleModeButton(bool pressed) {
+  if (pressed) {
+    modeHeld = true;
+    modeComboUsed = false;
+    return;
   }
 
-  if ((millis() - lastDebounceTime[numNoteButtons + 3]) > debounceDelay) {
-    if (reading != modeState) {
-      modeState = reading;
-
-      if (modeState == LOW) {
-        stopAllPlayingNotes();
-        currentMode = (ControllerMode)((currentMode + 1) % MODE_COUNT);
-        
-        // Reset offsets when changing modes
-        if (currentMode == MODE_STANDARD) {
-          octaveOffset = 0;
-        } else if (currentMode == MODE_SCALES) {
-          semitoneOffset = 0;
-        }
-        
-        updateDisplay();
-      }
-    }
+  modeHeld = false;
+  if (modeComboUsed) {
+    return;
   }
 
-  lastModeState = reading;
-}
-
-// === STOP ALL PLAYING NOTES ===
-// This function is defined in midi_functions.h to avoid redefinition
-
-// === UPDATE ALL BUTTONS BASED ON CURRENT MODE ===
-void updateButtons() {
-  // Handle mode button (always active)
-  handleModeButton();
+  stopAllPlayingNotes();
+  currentMode = (ControllerMode)((currentMode + 1) % MODE_COUNT);
   
+  // Reset offsets when changing modes
   if (currentMode == MODE_STANDARD) {
-    // Handle 7 note buttons
-    for (int i = 0; i < numNoteButtons; i++) {
-      handleNoteButton(i);
-    }
-    handleSharpButton();
-    handleOctaveButtons();
-    
+    octaveOffset = 0;
   } else if (currentMode == MODE_SCALES) {
-    // Handle 7 note buttons
-    for (int i = 0; i < numNoteButtons; i++) {
-      handleNoteButton(i);
-    }
-    handleScaleButton(); // Sharp button becomes scale selector
-    handleTransposeButtons(); // Octave buttons become transpose
-    
-  } else if (currentMode == MODE_DRUMS) {
-    // Handle all 10 buttons as drums (7 main + 3 extra)
-    for (int i = 0; i < numNoteButtons; i++) {
-      handleNoteButton(i); // These will play drums in drum mode
-    }
-    // Handle the 3 extra buttons (sharp, octave down, octave up) as drums
-    handleDrumButton(numNoteButtons, sharpPin);     // Button 8
-    handleDrumButton(numNoteButtons + 1, octaveDownPin); // Button 9
-    handleDrumButton(numNoteButtons + 2, octaveUpPin);   // Button 10
+    semitoneOffset = 0;
   }
+  
+  updateDisplay();
+}
+
+// === FUNCTION BUTTONS (MODE HELD) ===
+// Mode + note 1-4:    recall preset bank 1-4
+// Mode + note 5:      looper quantize on/off
+// Mode + note 6:      save the loop
+// Mode + note 7:      save the current settings to the active preset
+// Mode + sharp:       looper record / overdub
+// Mode + octave down: looper undo
+// Mode + octave up:   looper play / stop
+// Only presses come here: a button already down when mode went down still
+// plays, and its release goes to its own handler as usual.
+void handleFunctionButton(int index) {
+  modeComboUsed = true;
+
+  if (index < presetBankCount) {
+    stopAllPlayingNotes();
+    selectPreset(index);
+    showGlyphs(GLYPH_PRESET_FIRST + index);
+    updateDisplay();   // The preset may change mode and scale
+  } else if (index == numNoteButtons - 1) {
+    savePreset();
+    showGlyphs(GLYPH_SAVED);
+  } else if (index == looperQuantizeButton) {
+    handleLooperQuantizeButton();
+  } else if (index == looperSaveButton) {
+    handleLooperSaveButton();
+  } else if (index == sharpButton) {
+    handleLooperRecordButton();
+  } else if (index == octaveDownButton) {
+    handleLooperUndoButton();
+  } else if (index == octaveUpButton) {
+    handleLooperPlayButton();
+  } else {
+    return;
+  }
+
+  displayTimeout = millis() + DISPLAY_TIMEOUT;
 }
 
 #endif // BUTTON_HANDLERS_H
\ No newline at end of file
@@ -0,0 +1,196 @@
+/*
+ * chord_player.h - Chord Mode Player
+ * 
+ * In Chords mode each note button plays its chord slot from the active
+ * preset (chords.h): pitch class n of the mask sounds at
+ * (octave + 1) * 12 + n, routed by the button like any melodic note.
+ * 
+ * Without a strum the whole chord is reserved in the USB transfer being
+ * filled and goes out as one burst. With one, the notes follow each other
+ * chordStrumMs apart, upwards or downwards: the first goes out from the
+ * press, the rest from serviceChords(), which loop() calls from the same
+ * places as the arpeggiator, so no strum ever waits in delay() and other
+ * buttons play (and strum) in the meantime. The delay from a strummed
+ * note falling due to its reaching USB is the "strum" telemetry stage
+ * (STATS).
+ * 
+ * Each button remembers the notes it sent and releases exactly those, so
+ * a chord edited while held (SET_CHORD) can't leave a note stuck. Sharp
+ * flips the strum direction and the octave buttons set its spacing.
+ */
+
+#ifndef CHORD_PLAYER_H
+#define CHORD_PLAYER_H
+
+struct ChordVoice {
+  uint16_t pending;     // Pitch classes still to strum
+  uint16_t sounding;    // Pitch classes whose note-on has gone out
+  uint8_t base;         // MIDI note of pitch class 0
+  unsigned long due;    // micros() when the next pending note falls due
+};
+
+static_assert(numChords == numNoteButtons, "One chord slot per note button");
+
+// Function declarations
+void handleChordButton(int index, bool pressed);
+void handleStrumDirectionButton(bool pressed);
+void handleStrumTimeButton(int index, bool pressed);
+void serviceChords();
+void strumChordNote(uint8_t index);
+void releaseChord(uint8_t index);
+uint8_t chordPacketCount(uint8_t index, uint16_t pitches);
+void stopChords();
+
+// External variables needed for the chord player
+extern unsigned long displayTimeout;
+
+ChordVoice chordVoices[numChords];
+uint8_t chordStrumming = 0;   // Bit n = voice n has notes pending
+
+uint8_t chordStrumMs = 0;
+bool chordStrumDown = false;
+
+// === BUTTONS (CHORDS MODE) ===
+void handleChordButton(int index, bool pressed) {
+  if (!pressed) {
+    releaseChord(index);
+    return;
+  }
+
+  uint16_t mask = activePreset->chordMasks[index];
+  if (mask == 0) {
+    return;
+  }
+
+  ChordVoice& voice = chordVoices[index];
+  voice.base = (activePreset->chordOctaves[index] + 1) * 12;
+  voice.pending = mask;
+  voice.sounding = 0;
+
+  if (chordStrumMs == 0) {
+    reserveMidiTransfer(min(chordPacketCount(index, mask), midiPacketsPerTransfer));
+    while (voice.pending != 0) {
+      strumChordNote(index);
+    }
+  } else {
+    voice.due = micros() + chordStrumMs * 1000UL;
+    strumChordNote(index);
+    if (voice.pending != 0) {
+      chordStrumming |= 1 << index;
+    }
+  }
+
+  // The lowest note names the chord
+  uint8_t lowest = 0;
+  while (!(mask & (1 << lowest))) {
+    lowest++;
+  }
+  showNoteName(voice.base + lowest);
+  displayTimeout = millis() + DISPLAY_TIMEOUT;
+}
+
+void handleStrumDirectionButton(bool pressed) {
+  if (pressed) {
+    chordStrumDown = !chordStrumDown;
+    markDisplayDirty(REGION_DETAIL);
+  }
+}
+
+void handleStrumTimeButton(int index, bool pressed) {
+  if (!pressed) {
+    return;
+  }
+
+  if (index == octaveDownButton) {
+    chordStrumMs = max(chordStrumMs - chordStrumStep, 0);
+  } else {
+    chordStrumMs = min(chordStrumMs + chordStrumStep, (int)chordStrumMax);
+  }
+  markDisplayDirty(REGION_STATUS);
+}
+
+// === STRUM DISPATCH (LOOP CONTEXT) ===
+// One note per voice per call; a voice that fell behind catches up a note
+// a pass, keeping its spacing from the press rather than bunching up
+void serviceChords() {
+  if (chordStrumming == 0) {
+    return;
+  }
+
+  unsigned long now = micros();
+  for (uint8_t index = 0; index < numChords; index++) {
+    ChordVoice& voice = chordVoices[index];
+    if (!(chordStrumming & (1 << index)) || (long)(now - voice.due) < 0) {
+      continue;
+    }
+
+    unsigned long due = voice.due;
+    voice.due += chordStrumMs * 1000UL;
+    strumChordNote(index);
+    if (voice.pending == 0) {
+      chordStrumming &= ~(1 << index);
+    }
+
+    flushMidiQueue();
+    recordStage(STAGE_STRUM, micros() - due);
+  }
+}
+
+// Sends the lowest pending note, or the highest when strumming down
+void strumChordNote(uint8_t index) {
+  ChordVoice& voice = chordVoices[index];
+  uint8_t pitch;
+  if (chordStrumDown) {
+    pitch = 11;
+    while (!(voice.pending & (1 << pitch))) {
+      pitch--;
+    }
+  } else {
+    pitch = 0;
+    while (!(voice.pending & (1 << pitch))) {
+      pitch++;
+    }
+  }
+
+  voice.pending &= ~(1 << pitch);
+  voice.sounding |= 1 << pitch;
+  playRoutedNote(index, voice.base + pitch, 127);
+}
+
+// Notes not strummed yet are dropped; the sounding ones end in one burst
+void releaseChord(uint8_t index) {
+  ChordVoice& voice = chordVoices[index];
+  voice.pending = 0;
+  chordStrumming &= ~(1 << index);
+  if (voice.sounding == 0) {
+    return;
+  }
+
+  reserveMidiTransfer(min(chordPacketCount(index, voice.sounding), midiPacketsPerTransfer));
+  for (uint8_t pitch = 0; pitch < 12; pitch++) {
+    if (voice.sounding & (1 << pitch)) {
+      releaseRoutedNote(index, voice.base + pitch);
+    }
+  }
+  voice.sounding = 0;
+}
+
+uint8_t chordPacketCount(uint8_t index, uint16_t pitches) {
+  uint8_t notes = 0;
+  for (; pitches != 0; pitches >>= 1) {
+    notes += pitches & 1;
+  }
+  return notes * routeFanoutCount(index);
+}
+
+// stopAllPlayingNotes() has already silenced every channel (mode or preset
+// change), so the voices are just forgotten
+void stopChords() {
+  for (uint8_t index = 0; index < numChords; index++) {
+    chordVoices[index].pending = 0;
+    chordVoices[index].sounding = 0;
+  }
+  chordStrumming = 0;
+}
+
+#endif // CHORD_PLAYER_H
@@ -0,0 +1,24 @@
+/*
+ * chords.h - Chord Definitions
+ * 
+ * This file defines the 7 chord slots edited by the web configurator
+ * (midi-config.html). Each chord is a 12-bit pitch-class mask, bit n set
+ * meaning pitch class n (0 = C, 11 = B) is in the chord, plus the octave
+ * it is played in. The chords themselves are part of each preset
+ * (presets.h); these are the factory defaults. Chords mode plays them
+ * (chord_player.h).
+ */
+
+#ifndef CHORDS_H
+#define CHORDS_H
+
+const uint8_t numChords = 7;
+const uint16_t chordMaskAll = 0x0FFF;
+const uint8_t minChordOctave = 0;
+const uint8_t maxChordOctave = 8;   // (8 + 1) * 12 + 11 = 119 stays within MIDI
+
+// Defaults match the configurator's: C, D, E, F, G, A, B triads
+const uint16_t defaultChordMasks[numChords] PROGMEM = {0x091, 0x244, 0x910, 0x221, 0x884, 0x212, 0x848};
+const uint8_t defaultChordOctave = 4;
+
+#endif // CHORDS_H
@@ -12,60 +12,266 @@
 // OLED Display settings
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 32
-#define OLED_RESET -1
 #define SCREEN_ADDRESS 0x3C
 
-// Create display object
-extern Adafruit_SSD1306 display;
+// Print a PROGMEM string through Print
+#ifndef FPSTR
+#define FPSTR(pstr) (reinterpret_cast<const __FlashStringHelper *>(pstr))
+#endif
 
-// Button pins
-extern const int notePins[7];
-extern const int sharpPin;
-extern const int octaveDownPin;
-extern const int octaveUpPin;
-extern const int modePin;
+// Boot splash screen: shown while the controller is already live; build with
+// -DSHOW_SPLASH=0 to leave it out entirely
+#ifndef SHOW_SPLASH
+#define SHOW_SPLASH 1
+#endif
+
+// Button input backend (input.h): buttons straight on GPIO pins, chained
+// 74HC165 shift registers on hardware SPI, or MCP23017 expanders sharing
+// the display's I2C bus; build with e.g. -DINPUT_BACKEND=INPUT_SHIFT_REGISTER
+#define INPUT_GPIO 0
+#define INPUT_SHIFT_REGISTER 1
+#define INPUT_MCP23017 2
+
+#ifndef INPUT_BACKEND
+#define INPUT_BACKEND INPUT_GPIO
+#endif
+
+#if SHOW_SPLASH
+extern const unsigned long splashTitleTime;
+extern const unsigned long splashCreditsTime;
+#endif
+
+// Asynchronous frame transfer
+extern const uint32_t displayI2CClock;
+extern const uint8_t displayChunkSize;
+extern const unsigned long displayFlushBudget;
+
+// Display list (renderer.h)
+extern const uint8_t displayListSize;
+extern const uint8_t displayTextPoolSize;
+extern const uint8_t displayMaxFps;
+
+// Input lines of the logical buttons, and the expanders behind them
+extern const uint8_t keyMap[];
+extern const uint8_t shiftRegisterCount;
+extern const int shiftLoadPin;
+extern const uint8_t expanderCount;
+extern const uint8_t expanderAddress;
+extern const unsigned long expanderReadInterval;
 
 // Constants
 extern const int numNoteButtons;
+extern const int numButtons;
+
+// Logical button indices (bit positions in the input snapshot)
+extern const int sharpButton;
+extern const int octaveDownButton;
+extern const int octaveUpButton;
+extern const int modeButton;
+extern const int firstKeyboardButton;
+extern const int numKeyboardButtons;
 
 // Standard mode - Base MIDI notes for C4 scale (60 = C4)
-extern const int baseNotes[7];
-extern const String noteNames[7];
+extern const uint8_t baseNotes[7];
+extern const char noteNames[12][3];
+
+// Octave (Standard) and transpose (Scales) ranges
+extern const int minOctaveOffset;
+extern const int maxOctaveOffset;
+extern const int minSemitoneOffset;
+extern const int maxSemitoneOffset;
+extern const int scaleRootNote;
+extern const int keyboardBaseNote;
+extern const int drumKeyboardBaseNote;
 
 // MIDI settings
 extern const int midiChannel;
 extern const int velocity;
 extern const int drumChannel;
+extern const uint8_t routeLayerCount;
+extern const int routeMaxTranspose;
+extern const uint8_t activeNoteChannelCount;
+extern const uint8_t activeNoteCapacity;
+extern const uint8_t noNote;
+extern const uint8_t noChannel;
 
 // Timing constants
 extern const unsigned long debounceDelay;
+extern const unsigned long debounceSampleInterval;
+extern const bool eagerDebounce;
+extern const uint8_t buttonEventQueueSize;
 extern const unsigned long DISPLAY_TIMEOUT;
 extern const unsigned long ANIMATION_DELAY;
+extern const unsigned long idleAnimationTimeout;
+extern const unsigned long loopIdlePeriod;
+
+// Outgoing USB MIDI queue
+extern const uint8_t midiQueueSize;
+extern const uint8_t midiPacketsPerTransfer;
+extern const uint8_t midiInputPacketsPerPass;
+
+// Arpeggiator
+extern const uint8_t arpDefaultBpm;
+extern const uint8_t arpMinBpm;
+extern const uint8_t arpMaxBpm;
+extern const uint8_t arpBpmStep;
+extern const uint8_t arpStepsPerBeat;
+extern const uint8_t midiClocksPerBeat;
+extern const unsigned long arpClockTimeout;
+extern const uint8_t arpStepQueueSize;
+
+// Chord mode strum
+extern const uint8_t chordStrumMax;
+extern const uint8_t chordStrumStep;
+
+// Serial command input
+extern const uint8_t serialLineSize;
+extern const uint8_t serialBytesPerPass;
+
+// EEPROM presets
+extern const uint8_t presetBankCount;
+extern const uint8_t presetSlotsPerBank;
+extern const uint8_t presetHeaderSlots;
+extern const uint16_t presetEepromSize;
+
+// Phrase looper
+extern const uint8_t looperBufferSize;
+extern const uint8_t looperMaxLayers;
+extern const uint8_t looperEventQueueSize;
+extern const uint8_t looperMaxSounding;
+extern const uint16_t looperMaxLength;
+extern const uint8_t looperQuantizeButton;
+extern const uint8_t looperSaveButton;
 
-// Initialize display object
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+#if SHOW_SPLASH
+const unsigned long splashTitleTime = 2000;     // "Midi Calc Controller" page
+const unsigned long splashCreditsTime = 2500;   // Author / year page
+#endif
 
-// Button pins
-const int notePins[] = {16, 7, 4, 14, 8, 5, 15}; // Buttons 1-7
-const int sharpPin = 6;        // Button 8 (Sharp/Scale selector)
-const int octaveDownPin = 8;   // Button 9 (Octave/Transpose down)
-const int octaveUpPin = 10;     // Button 10 (Octave/Transpose up)
-const int modePin = A0;         // Button 11 (Mode selector)
+const uint32_t displayI2CClock = 400000;
+const uint8_t displayChunkSize = 16;            // Data bytes per I2C transaction (Wire buffer is 32)
+const unsigned long displayFlushBudget = 500;   // Max microseconds of I2C per loop() pass
+
+const uint8_t displayListSize = 12;             // Text/bitmap items per screen
+const uint8_t displayTextPoolSize = 32;         // Characters of RAM text per screen
+const uint8_t displayMaxFps = 30;               // Redraws per second at most
+
+// Input line of every logical button, indexed like the snapshot bits
+// (constexpr so input.h can resolve the wiring at compile time)
+#if INPUT_BACKEND == INPUT_GPIO
+// Lines are Arduino pins
+constexpr uint8_t keyMap[] = {
+  16, 7, 4, 14, 8, 5, 15,  // Buttons 1-7 (notes)
+  6,                       // Button 8 (Sharp/Scale selector)
+  9,                       // Button 9 (Octave/Transpose down)
+  10,                      // Button 10 (Octave/Transpose up)
+  A0                       // Button 11 (Mode selector)
+};
+#else
+// Lines are expander inputs, numbered as described in input.h
+constexpr uint8_t keyMap[] = {
+  0, 1, 2, 3, 4, 5, 6,     // Buttons 1-7 (notes)
+  7, 8, 9, 10,             // Sharp, octave down, octave up, mode
+  11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21,  // Keyboard keys, chromatic
+  22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+};
+#endif
+
+// 74HC165 chain (INPUT_SHIFT_REGISTER): 8 lines per register on SCK/MISO
+const uint8_t shiftRegisterCount = 4;      // 8 for 64 keys
+const int shiftLoadPin = 10;               // To every register's SH/LD
+
+// MCP23017s (INPUT_MCP23017): 16 lines each, at consecutive addresses
+const uint8_t expanderCount = 2;           // 4 for 64 keys
+const uint8_t expanderAddress = 0x20;      // A2-A0 low on the first one
+const unsigned long expanderReadInterval = 1000;  // Microseconds between reads
 
 const int numNoteButtons = 7;
+const int numButtons = sizeof(keyMap) / sizeof(keyMap[0]);
+
+// Logical button indices (bit positions in the input snapshot)
+const int sharpButton = 7;
+const int octaveDownButton = 8;
+const int octaveUpButton = 9;
+const int modeButton = 10;
+const int firstKeyboardButton = 11;        // Buttons past the panel play chromatically
+const int numKeyboardButtons = numButtons - firstKeyboardButton;
 
 // Standard mode - Base MIDI notes for C4 scale (60 = C4)
-const int baseNotes[] = {60, 62, 64, 65, 67, 69, 71}; // C, D, E, F, G, A, B
-const String noteNames[] = {"C", "D", "E", "F", "G", "A", "B"};
+// (only read at compile time to build the note tables in note_tables.h)
+constexpr uint8_t baseNotes[] = {60, 62, 64, 65, 67, 69, 71}; // C, D, E, F, G, A, B
+
+// Note names by pitch class, kept in flash
+const char noteNames[12][3] PROGMEM = {
+  "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
+};
+
+// Octave (Standard) and transpose (Scales) ranges
+const int minOctaveOffset = -3;
+const int maxOctaveOffset = 3;
+const int minSemitoneOffset = -24;
+const int maxSemitoneOffset = 24;
+const int scaleRootNote = 60; // C4
+const int keyboardBaseNote = 48;      // C3, lowest keyboard key
+const int drumKeyboardBaseNote = 35;  // Acoustic bass drum, lowest keyboard key in Drums mode
 
 // MIDI settings
 const int midiChannel = 0;
 const int velocity = 100;
 const int drumChannel = 9; // Channel 10 (9 in 0-indexed) for drums
+const uint8_t routeLayerCount = 4;         // Split/layer outputs (routing.h)
+const int routeMaxTranspose = 48;          // Semitones either way per layer
+const uint8_t activeNoteChannelCount = routeLayerCount + 1;  // Layers + drums, reference-counted (active_notes.h)
+const uint8_t activeNoteCapacity = 32;     // Distinct notes tracked at once, 3 bytes each
+const uint8_t noNote = 0xFF;               // Button not holding a note
+const uint8_t noChannel = 0xFF;            // Layer turned off
 
 // Timing constants
-const unsigned long debounceDelay = 50;
+const unsigned long debounceDelay = 20;   // Input must be stable this long to change state
+const unsigned long debounceSampleInterval = debounceDelay / 4; // 4 samples per window
+const bool eagerDebounce = true;          // Fire note-on at the first contact edge
+const uint8_t buttonEventQueueSize = 32;  // Scanner -> loop() events, power of two
 const unsigned long DISPLAY_TIMEOUT = 2000;
 const unsigned long ANIMATION_DELAY = 500;
+const unsigned long idleAnimationTimeout = 60000;  // No buttons this long (ms): the animation stops
+const unsigned long loopIdlePeriod = 1000;         // Idle sleep after each loop() pass (us)
+
+// Outgoing USB MIDI queue
+const uint8_t midiQueueSize = 64;          // Packets, must be a power of two
+const uint8_t midiPacketsPerTransfer = 16; // 64-byte endpoint / 4-byte packets
+const uint8_t midiInputPacketsPerPass = 16; // Incoming packets handled per loop() pass
+
+// Arpeggiator
+const uint8_t arpDefaultBpm = 120;         // Internal tempo when no MIDI clock arrives
+const uint8_t arpMinBpm = 40;
+const uint8_t arpMaxBpm = 240;
+const uint8_t arpBpmStep = 5;              // Per octave button press
+const uint8_t arpStepsPerBeat = 4;         // Sixteenth notes
+const uint8_t midiClocksPerBeat = 24;
+const unsigned long arpClockTimeout = 500; // ms without 0xF8 before falling back to the internal tempo
+const uint8_t arpStepQueueSize = 8;        // Timer -> loop() steps, power of two
+
+// Chord mode strum
+const uint8_t chordStrumMax = 50;          // ms between strummed notes at most; 0 plays them together
+const uint8_t chordStrumStep = 5;          // Per octave button press
+
+// Serial command input
+const uint8_t serialLineSize = 48;         // Longest command line, including the terminator
+const uint8_t serialBytesPerPass = 16;     // Bytes consumed per loop() pass
+
+// EEPROM presets
+const uint8_t presetBankCount = 4;         // Recalled with mode + note buttons 1-4
+const uint8_t presetSlotsPerBank = 4;      // Wear-leveling ring per bank
+const uint8_t presetHeaderSlots = 8;       // Wear-leveling ring for the active bank record
+const uint16_t presetEepromSize = 768;     // EEPROM bytes 0-767; the rest is free
+
+// Phrase looper
+const uint8_t looperBufferSize = 192;      // Encoded events, about 3 bytes each
+const uint8_t looperMaxLayers = 8;         // First take plus overdubs
+const uint8_t looperEventQueueSize = 8;    // Timer -> loop() events, power of two
+const uint8_t looperMaxSounding = 12;      // Loop notes sounding at once
+const uint16_t looperMaxLength = 60000;    // ms; a longer first take ends by itself
+const uint8_t looperQuantizeButton = 4;    // Mode + note 5
+const uint8_t looperSaveButton = 5;        // Mode + note 6
 
 #endif // CONFIG_H
\ No newline at end of file
@@ -0,0 +1,49 @@
+/*
+ * debounce.h - Button Debouncing
+ * 
+ * This file debounces all buttons in parallel on the input snapshot bitmask
+ * using 2-bit vertical counters: a button only changes state after its raw
+ * reading has disagreed for four samples in a row. In eager mode a press is
+ * accepted on the very first contact edge instead, and the counters then
+ * hold the button down through its bounce until it is really released.
+ */
+
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+// Function declarations
+void debounceButtons(ButtonMask raw, unsigned long now);
+
+// Bit n set = logical button n is (debounced) held down
+volatile ButtonMask debouncedButtons = 0;
+
+// Vertical counters: bit n of count0/count1 form button n's 2-bit counter
+ButtonMask debounceCount0 = 0;
+ButtonMask debounceCount1 = 0;
+unsigned long lastDebounceSample = 0;
+
+// === DEBOUNCE ENGINE ===
+// Call once per scan with the raw snapshot and the scan's timestamp.
+void debounceButtons(ButtonMask raw, unsigned long now) {
+  if (eagerDebounce) {
+    // First contact edge of a released button counts as a press straight away
+    ButtonMask pressEdges = raw & ~debouncedButtons;
+    debouncedButtons |= pressEdges;
+    debounceCount0 &= ~pressEdges;
+    debounceCount1 &= ~pressEdges;
+  }
+
+  if (now - lastDebounceSample < debounceSampleInterval) {
+    return;
+  }
+  lastDebounceSample = now;
+
+  // Count samples that disagree with the debounced state; any agreeing
+  // sample resets that button's counter, and a count of four flips it
+  ButtonMask delta = raw ^ debouncedButtons;
+  debounceCount1 = (debounceCount1 ^ debounceCount0) & delta;
+  debounceCount0 = ~debounceCount0 & delta;
+  debouncedButtons ^= delta & ~(debounceCount0 | debounceCount1);
+}
+
+#endif // DEBOUNCE_H
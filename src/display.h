@@ -2,148 +2,471 @@
  * display.h - Display Functions
  * 
  * This file contains all display-related functions for the OLED screen,
- * including mode-specific displays and animations.
+ * including mode-specific displays and animations. Screens are built as
+ * display lists (renderer.h) and rendered while they are sent.
  */
 
 #ifndef DISPLAY_H
 #define DISPLAY_H
 
+#if SHOW_SPLASH
 static const unsigned char PROGMEM image_calculator_bits[] = {0x7f,0xe0,0x80,0x10,0xbf,0xd0,0xa0,0x50,0xbf,0xd0,0x80,0x10,0xb6,0xd0,0xb6,0xd0,0x80,0x10,0xb6,0xd0,0xb6,0xd0,0x80,0x10,0xb6,0xd0,0xb6,0xd0,0x80,0x10,0x7f,0xe0};
 
 static const unsigned char PROGMEM image_music_sound_wave_bits[] = {0x00,0x00,0x00,0x02,0x00,0x00,0x02,0x20,0x00,0x02,0x20,0x00,0x02,0x20,0x00,0x0a,0x28,0x00,0x0a,0xa8,0x00,0x2a,0xa8,0x00,0xaa,0xaa,0x80,0x0a,0xaa,0x00,0x0a,0xa8,0x00,0x0a,0x20,0x00,0x02,0x20,0x00,0x02,0x20,0x00,0x02,0x00,0x00,0x00,0x00,0x00};
 
+#endif
+
 static const unsigned char PROGMEM image_music_bits[] = {0x00,0x7c,0x0f,0x84,0x08,0x04,0x08,0x7c,0x0f,0xc4,0x08,0x04,0x08,0x04,0x08,0x04,0x08,0x04,0x08,0x04,0x08,0x38,0x70,0x44,0x88,0x44,0x88,0x38,0x70,0x00,0x00,0x00};
 
 
 // Function declarations
 void startupDisplay();
+#if SHOW_SPLASH
+void drawSplashTitle();
+void drawSplashCredits();
+void serviceSplash();
+#endif
+bool splashShowing();
 void updateDisplay();
+void markDisplayDirty(uint8_t region);
+void markDisplayRect(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn);
+void serviceDisplay();
+void buildDisplayList();
+void drawModeScreen();
 void drawAnimatedKeyboard();
 void drawAnimatedScale();
 void drawAnimatedDrums();
-String getScaleNoteName(int buttonIndex);
+void stepIdleAnimation();
+void markAnimationElement(uint8_t element);
+uint8_t renderAnimationColumn(const DisplayItem& item, uint8_t dx, uint8_t top);
+void showNoteName(int midiNote);
+void showGlyphs(uint8_t glyph);
+void serviceDisplayFlush();
+// Note: buttonEventPending() is defined in scanner.h
+bool buttonEventPending();
+// Note: serviceArpeggiator() and arpFollowingClock() are defined in arpeggiator.h
+void serviceArpeggiator();
+bool arpFollowingClock();
+// Note: serviceLooper() is defined in looper.h
+void serviceLooper();
+// Note: serviceChords() is defined in chord_player.h
+void serviceChords();
+// Note: sharpHeld() is defined in button_handlers.h
+bool sharpHeld();
 
 // External variables needed for display functions
 extern ControllerMode currentMode;
-extern ScaleType currentScale;
-extern bool sharpState;
+extern uint8_t currentScale;
 extern int currentOctave;
+extern int octaveOffset;
 extern int semitoneOffset;
-extern String currentNote;
+extern uint8_t currentNoteGlyphs[];
 extern int animationFrame;
+extern uint8_t arpPattern;
+extern uint8_t arpBpm;
+extern uint8_t chordStrumMs;
+extern bool chordStrumDown;
 
-void startupDisplay() { 
-  display.clearDisplay();
+// Render time of the frame being sent, recorded as STAGE_RENDER
+unsigned long displayListTime = 0;   // Building its display list
+unsigned long displayRasterTime = 0; // Rendering its chunks
 
-  display.setTextColor(1);
-  display.setTextWrap(false);
-  display.setCursor(38, 6);
-  display.print("Midi Calc");
+// === DIRTY REGIONS ===
+// Handlers don't draw: they mark the part of the screen their change
+// affects, and serviceDisplay() redraws the marked columns of each page at
+// most displayMaxFps times a second. Every frame is rendered from a
+// complete display list, so regions may overlap freely.
+enum DisplayRegion {
+  REGION_TITLE = 0,    // Mode name
+  REGION_STATUS = 1,   // Octave, transpose, tempo or strum time
+  REGION_DETAIL = 2,   // Scale, pattern or strum direction
+  REGION_NOTE = 3,     // Note name, sharp sign and idle animation
+  REGION_ALL = 4
+};
 
-  display.setCursor(35, 17);
-  display.print("Controller");
+// First page, last page, first column, last column
+const uint8_t displayRegions[5][4] PROGMEM = {
+  {0, 1, 0, 86},
+  {0, 1, 87, SCREEN_WIDTH - 1},
+  {1, 3, 0, 79},
+  {1, 3, 80, SCREEN_WIDTH - 1},
+  {0, SCREEN_HEIGHT / 8 - 1, 0, SCREEN_WIDTH - 1}
+};
 
-  display.drawBitmap(14, 8, image_calculator_bits, 12, 16, 1);
+// Dirty columns per page; first > last when the page is clean
+uint8_t dirtyFirstColumn[SCREEN_HEIGHT / 8] = {0xFF, 0xFF, 0xFF, 0xFF};
+uint8_t dirtyLastColumn[SCREEN_HEIGHT / 8] = {0, 0, 0, 0};
+bool displayDirty = false;
+unsigned long lastFrameTime = 0;
 
-  display.drawBitmap(100, 8, image_music_sound_wave_bits, 17, 16, 1);
+// Frame being sent (see ASYNCHRONOUS FRAME TRANSFER)
+bool displayFlushActive = false;
+uint8_t flushFirstColumn[SCREEN_HEIGHT / 8];  // Next column to send, per page
+uint8_t flushLastColumn[SCREEN_HEIGHT / 8];
+uint8_t flushPage = 0;
+uint8_t flushWindowLastPage = 0xFF;           // Last page of the open window, 0xFF if none
 
-  display.display();
+// === SPLASH SCREEN ===
+// The splash is a timed display state advanced from loop(), not a delay:
+// buttons and USB MIDI are live the whole time, and any redraw (a button
+// press, for instance) ends it early. With SHOW_SPLASH=0 only
+// startupDisplay() and splashShowing() are left.
+#if SHOW_SPLASH
+enum SplashState {
+  SPLASH_DONE = 0,
+  SPLASH_TITLE = 1,
+  SPLASH_CREDITS = 2
+};
 
-  delay(2000);
+uint8_t splashState = SPLASH_DONE;
+unsigned long splashNextTime = 0;
+#endif
 
-  display.clearDisplay();
+void startupDisplay() {
+  updateDisplay();
+#if SHOW_SPLASH
+  splashState = SPLASH_TITLE;
+  splashNextTime = millis() + splashTitleTime;
+#endif
+}
 
-  display.setTextColor(1);
-  display.setTextWrap(false);
-  display.setCursor(35, 6);
-  display.print("fdtschmitz");
+bool splashShowing() {
+#if SHOW_SPLASH
+  return splashState != SPLASH_DONE;
+#else
+  return false;
+#endif
+}
 
-  display.setCursor(53, 17);
-  display.print("2025");
+#if SHOW_SPLASH
 
-  display.display();
-};
+void drawSplashTitle() {
+  drawTextP(38, 6, PSTR("Midi Calc"), 1);
+  drawTextP(35, 17, PSTR("Controller"), 1);
+  drawBitmapP(14, 8, image_calculator_bits, 12, 16);
+  drawBitmapP(100, 8, image_music_sound_wave_bits, 17, 16);
+}
+
+void drawSplashCredits() {
+  drawTextP(35, 6, PSTR("fdtschmitz"), 1);
+  drawTextP(53, 17, PSTR("2025"), 1);
+}
 
+void serviceSplash() {
+  if (splashState == SPLASH_DONE) {
+    return;
+  }
+
+  // Holding any button skips straight to the mode screen
+  if (appliedButtons != 0) {
+    updateDisplay();
+    return;
+  }
+
+  if ((long)(millis() - splashNextTime) < 0) {
+    return;
+  }
+
+  if (splashState == SPLASH_TITLE) {
+    updateDisplay();
+    splashState = SPLASH_CREDITS;
+    splashNextTime = millis() + splashCreditsTime;
+  } else {
+    updateDisplay();
+  }
+}
+#endif
+
+// === MARKING ===
+// Redraw the whole screen (mode or preset change)
 void updateDisplay() {
-  display.clearDisplay();
-  
-  // Show current mode
-  display.setTextSize(1);
-  display.setTextColor(SSD1306_WHITE);
-  
-  // Show mode-specific info
-  if (currentMode == MODE_STANDARD) {
+  markDisplayDirty(REGION_ALL);
+}
 
-    display.setTextColor(1);
-    display.setTextWrap(false);
-    display.setCursor(2, 2);
-    display.print("Keyboard Mode");
+void markDisplayDirty(uint8_t region) {
+  uint8_t rect[4];
+  memcpy_P(rect, displayRegions[region], sizeof(rect));
+  markDisplayRect(rect[0], rect[1], rect[2], rect[3]);
+}
+
+void markDisplayRect(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn) {
+#if SHOW_SPLASH
+  // Any regular redraw replaces the splash, all of it
+  if (splashState != SPLASH_DONE) {
+    splashState = SPLASH_DONE;
+    firstPage = 0;
+    lastPage = SCREEN_HEIGHT / 8 - 1;
+    firstColumn = 0;
+    lastColumn = SCREEN_WIDTH - 1;
+  }
+#endif
+
+  for (uint8_t page = firstPage; page <= lastPage; page++) {
+    dirtyFirstColumn[page] = min(dirtyFirstColumn[page], firstColumn);
+    dirtyLastColumn[page] = max(dirtyLastColumn[page], lastColumn);
+  }
+  displayDirty = true;
+}
+
+// === FRAME SCHEDULER ===
+void serviceDisplay() {
+  if (displayFlushActive) {
+    serviceDisplayFlush();
+    return;
+  }
+
+  // Coalesce: no frame while the scanner has queued input, which will most
+  // likely dirty the screen again, nor sooner than the frame rate allows
+  if (!displayDirty || buttonEventPending() || millis() - lastFrameTime < 1000 / displayMaxFps) {
+    return;
+  }
+  lastFrameTime = millis();
+
+  unsigned long renderStart = micros();
+  buildDisplayList();
+  displayListTime = micros() - renderStart;
+  displayRasterTime = 0;
+
+  // The transfer takes this frame's dirty columns; new marks go to the next
+  for (uint8_t page = 0; page < SCREEN_HEIGHT / 8; page++) {
+    flushFirstColumn[page] = dirtyFirstColumn[page];
+    flushLastColumn[page] = dirtyLastColumn[page];
+    dirtyFirstColumn[page] = 0xFF;
+    dirtyLastColumn[page] = 0;
+  }
+  displayDirty = false;
+  displayFlushActive = true;
+  flushPage = 0;
+  flushWindowLastPage = 0xFF;
 
-    display.setCursor(87, 2);
-    display.print("Oct:");
+  serviceDisplayFlush();
+}
+
+void buildDisplayList() {
+  clearDisplayList();
+
+#if SHOW_SPLASH
+  if (splashState == SPLASH_TITLE) {
+    drawSplashTitle();
+    return;
+  }
+  if (splashState == SPLASH_CREDITS) {
+    drawSplashCredits();
+    return;
+  }
+#endif
+  drawModeScreen();
+}
+
+void drawModeScreen() {
+  // Show mode-specific info
+  if (currentMode == MODE_STANDARD) {
+    drawGlyphs(2, 2, GLYPH_KEYBOARD_MODE);
+    drawGlyphs(87, 2, GLYPH_OCTAVE_LABEL);
     // Show current octave
-    display.setCursor(114, 2);
-    display.print(currentOctave);
+    drawNumber(114, 2, currentOctave + octaveOffset, 1, false);
     
     // Show sharp indicator
-    if (sharpState == LOW) {
-      display.setCursor(110, 13);
-      display.setTextSize(2);
-      display.print("#");
+    if (sharpHeld()) {
+      drawTextP(110, 13, PSTR("#"), 2);
     }
   } else if (currentMode == MODE_SCALES) {
-    // Show current scale
-    display.setTextColor(1);
-    display.setTextWrap(false);
-    display.setTextSize(1);
-    display.setCursor(2, 2);
-    display.print("Scale Mode");
-    display.setCursor(87, 2);
-      
-    display.setCursor(2, 13);
-    // display.setTextSize(2);
-    display.print(scaleNames[currentScale]);
+    drawGlyphs(2, 2, GLYPH_SCALE_MODE);
     
     // Show current transposition
-    display.print("T:");
-    if (semitoneOffset >= 0) {
-      display.setTextSize(1);
-      display.setCursor(114, 2);
-      display.print("+");
-    }
-    display.print(semitoneOffset);
+    drawGlyphs(87, 2, GLYPH_TRANSPOSE_LABEL);
+    drawNumber(99, 2, semitoneOffset, 1, true);
     
+    // Show current scale; the library is too big to pre-render every name
+    if (currentScale < scaleCount) {
+      drawTextP(2, 13, scaleNames[currentScale], 1);
+    } else {
+      drawTextP(2, 13, PSTR("User"), 1);
+      drawNumber(32, 13, currentScale - scaleCount + 1, 1, false);
+    }
   } else if (currentMode == MODE_DRUMS) {
-    display.setCursor(2, 2);
-    display.print("Drum Mode");
+    drawGlyphs(2, 2, GLYPH_DRUM_MODE);
+  } else if (currentMode == MODE_ARP) {
+    drawGlyphs(2, 2, GLYPH_ARP_MODE);
+
+    // Tempo, or the host's when following MIDI clock
+    if (arpFollowingClock()) {
+      drawGlyphs(87, 2, GLYPH_SYNC_LABEL);
+    } else {
+      drawNumber(87, 2, arpBpm, 1, false);
+    }
+
+    drawGlyphs(2, 13, GLYPH_ARP_PATTERN_FIRST + arpPattern);
+  } else if (currentMode == MODE_CHORDS) {
+    drawGlyphs(2, 2, GLYPH_CHORD_MODE);
+
+    // Strum time, 0 when the notes go out together
+    drawNumber(87, 2, chordStrumMs, 1, false);
+    drawGlyphs(chordStrumMs < 10 ? 93 : 99, 2, GLYPH_MS_LABEL);
+
+    drawGlyphs(2, 13, chordStrumDown ? GLYPH_STRUM_DOWN : GLYPH_STRUM_UP);
   }
   
   // Current note or animated display
-  if (currentNote != "") {
+  if (currentNoteGlyphs[0] != noGlyph) {
     // Show current note being played
-    display.setTextSize(2);
-    display.setCursor(80, 13);
-    display.print(currentNote);
-    
+    uint8_t width = drawGlyphs(80, 13, currentNoteGlyphs[0]);
+    if (currentNoteGlyphs[1] != noGlyph) {
+      drawGlyphs(80 + width, 13, currentNoteGlyphs[1]);
+    }
+  } else if (currentMode == MODE_STANDARD) {
+    drawAnimatedKeyboard();
+  } else if (currentMode == MODE_DRUMS) {
+    drawAnimatedDrums();
   } else {
-    // TODO
+    drawAnimatedScale();
   }
-  
-  display.display();
 }
 
+// === IDLE ANIMATIONS ===
+// Drawn procedurally, a column at a time, in the note area below row 16.
+// Each step only marks the columns of the element that stops and the one
+// that starts moving, so a step costs a few dozen bytes of I2C.
+enum AnimationKind {
+  ANIMATION_KEYBOARD = 0,   // Seven keys, one pressed down
+  ANIMATION_SCALE = 1,      // Rising steps with a note climbing them
+  ANIMATION_DRUMS = 2       // Two rows of five pads, one lit
+};
 
-String getScaleNoteName(int buttonIndex) {
-  int interval = scaleIntervals[currentScale][buttonIndex];
-  String noteNames[] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
-  
-  // Apply semitone transposition
-  int totalSemitones = (interval + semitoneOffset) % 12;
-  if (totalSemitones < 0) totalSemitones += 12;
-  
-  int octave = currentOctave + ((interval + semitoneOffset) / 12);
-  
-  return noteNames[totalSemitones] + String(octave);
+const uint8_t animationX = 80;
+const uint8_t animationY = 16;
+
+void drawAnimatedKeyboard() {
+  addDisplayItem(ITEM_ANIMATION, animationX, animationY, 27, 16, ANIMATION_KEYBOARD, NULL);
+}
+
+void drawAnimatedScale() {
+  addDisplayItem(ITEM_ANIMATION, animationX, animationY, 27, 16, ANIMATION_SCALE, NULL);
+}
+
+void drawAnimatedDrums() {
+  addDisplayItem(ITEM_ANIMATION, animationX, animationY, 28, 16, ANIMATION_DRUMS, NULL);
+}
+
+// Called every ANIMATION_DELAY while no note name is shown
+void stepIdleAnimation() {
+  uint8_t frames = (currentMode == MODE_DRUMS) ? 10 : 7;
+  markAnimationElement(animationFrame);
+  animationFrame = (animationFrame + 1) % frames;
+  markAnimationElement(animationFrame);
+}
+
+void markAnimationElement(uint8_t element) {
+  // Keys and steps are 4 columns apart, pads 6 (five to a row)
+  uint8_t column = currentMode == MODE_DRUMS ? (element % 5) * 6 : element * 4;
+  markDisplayRect(animationY / 8, SCREEN_HEIGHT / 8 - 1, animationX + column, animationX + column + 3);
+}
+
+uint8_t renderAnimationColumn(const DisplayItem& item, uint8_t dx, uint8_t top) {
+  if (item.scale == ANIMATION_DRUMS) {
+    if (dx % 6 >= 4) {
+      return 0;
+    }
+    // Lit pad is solid, the others just their bottom edge
+    uint8_t pad = dx / 6;
+    uint8_t bits = 0;
+    for (uint8_t row = 0; row < 2; row++) {
+      uint8_t bottom = animationY + 6 + row * 8;
+      bool lit = animationFrame == row * 5 + pad;
+      bits |= pageRows(lit ? bottom - 5 : bottom, bottom, top);
+    }
+    return bits;
+  }
+
+  if (dx % 4 == 3) {
+    return 0;
+  }
+  uint8_t element = dx / 4;
+
+  if (item.scale == ANIMATION_KEYBOARD) {
+    // The pressed key sits lower
+    return pageRows(animationFrame == element ? animationY + 5 : animationY + 1, animationY + 14, top);
+  }
+
+  // Step heights 2..8 from the bottom; the current one carries a note
+  uint8_t stepTop = SCREEN_HEIGHT - 2 - element;
+  uint8_t bits = pageRows(stepTop, SCREEN_HEIGHT - 1, top);
+  if (animationFrame == element) {
+    bits |= pageRows(stepTop - 5, stepTop - 3, top);
+  }
+  return bits;
+}
+
+// === ASYNCHRONOUS FRAME TRANSFER ===
+// The frame is rendered and streamed to the panel a chunk at a time from
+// loop(), straight from the display list (renderer.h). Only each page's
+// dirty columns are sent; consecutive pages with the same columns share
+// one addressing window.
+// Renders and sends display chunks until the per-pass time budget is used up
+void serviceDisplayFlush() {
+  const uint8_t pageCount = SCREEN_HEIGHT / 8;
+  unsigned long start = micros();
+
+  do {
+    // Skip pages with nothing (left) to send
+    while (flushPage < pageCount && flushFirstColumn[flushPage] > flushLastColumn[flushPage]) {
+      flushPage++;
+    }
+    if (flushPage == pageCount) {
+      displayFlushActive = false;
+      recordStage(STAGE_RENDER, displayListTime + displayRasterTime);
+      break;
+    }
+
+    if (flushWindowLastPage == 0xFF || flushPage > flushWindowLastPage) {
+      flushWindowLastPage = flushPage;
+      while (flushWindowLastPage + 1 < pageCount &&
+             flushFirstColumn[flushWindowLastPage + 1] == flushFirstColumn[flushPage] &&
+             flushLastColumn[flushWindowLastPage + 1] == flushLastColumn[flushPage]) {
+        flushWindowLastPage++;
+      }
+      ssd1306SetWindow(flushPage, flushWindowLastPage, flushFirstColumn[flushPage], flushLastColumn[flushPage]);
+    }
+
+    uint8_t column = flushFirstColumn[flushPage];
+    uint8_t count = min(flushLastColumn[flushPage] - column + 1, (int)displayChunkSize);
+    uint8_t chunk[displayChunkSize];
+
+    unsigned long rasterStart = micros();
+    renderDisplayChunk(flushPage, column, chunk, count);
+    displayRasterTime += micros() - rasterStart;
+    ssd1306Data(chunk, count);
+
+    if (column + count > flushLastColumn[flushPage]) {
+      flushFirstColumn[flushPage] = 0xFF;   // Page done
+      flushLastColumn[flushPage] = 0;
+    } else {
+      flushFirstColumn[flushPage] = column + count;
+    }
+
+    // Arpeggiator steps, loop events and strums don't wait for the rest of the frame
+    serviceArpeggiator();
+    serviceLooper();
+    serviceChords();
+  } while (micros() - start < displayFlushBudget);
+
+  recordStage(STAGE_I2C, micros() - start);
+}
+
+// Shows e.g. "C#4" for a MIDI note (60 = C4), built from pitch class and
+// octave strips of the glyph cache
+void showNoteName(int midiNote) {
+  currentNoteGlyphs[0] = GLYPH_PITCH_FIRST + midiNote % 12;
+  currentNoteGlyphs[1] = GLYPH_OCTAVE_FIRST + midiNote / 12;
+  markDisplayDirty(REGION_NOTE);
+}
+
+// Shows a drum name or message in place of the note name, or the idle
+// animation for noGlyph
+void showGlyphs(uint8_t glyph) {
+  currentNoteGlyphs[0] = glyph;
+  currentNoteGlyphs[1] = noGlyph;
+  markDisplayDirty(REGION_NOTE);
 }
 
 #endif // DISPLAY_H
\ No newline at end of file
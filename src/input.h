@@ -0,0 +1,290 @@
+/*
+ * input.h - Button Input Capture
+ * 
+ * This file reads every button at once into a packed bitmask, so every
+ * handler in a scan works from the same snapshot. Bit n is logical button
+ * n; keyMap in config.h says which input line each one is wired to, and is
+ * resolved at compile time. INPUT_BACKEND picks where the lines come from:
+ *   - INPUT_GPIO: the ATmega32U4 port input registers, lines are Arduino
+ *     pins. Enough for the 11 panel buttons.
+ *   - INPUT_SHIFT_REGISTER: chained 74HC165s on hardware SPI, latched
+ *     together by shiftLoadPin and clocked out LSB first at 8 MHz from the
+ *     scan interrupt. Line 8r + 0 is the H input of register r (r = 0
+ *     feeds MISO), line 8r + 7 its A input.
+ *   - INPUT_MCP23017: expanders on the display's I2C bus. Line 16e + b is
+ *     GPA b of expander e, line 16e + 8 + b its GPB b. Wire can't run in an
+ *     interrupt, so loop() reads every expander in one burst with
+ *     serviceInputExpanders() and the scan interrupt debounces the latest.
+ * 
+ * Estimated scan time with 64 keys, worked out from bus timing and
+ * instruction counts. These figures are unverified on hardware; the "scan"
+ * STATS stage reports the real ones on a board:
+ *   - 8 x 74HC165: 8 us of SPI, about 16 us to gather the bits and 10 us
+ *     to debounce them, well inside the 1 ms scan period.
+ *   - 4 x MCP23017 at 400 kHz: 0.49 ms of bus time per burst, so the lines
+ *     are sampled about once a loop() pass (roughly 1 kHz) and share the
+ *     bus with the display transfer.
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+// Function declarations
+void startInputs();
+void scanButtons();
+void serviceInputExpanders();
+
+static_assert(numButtons <= 64, "keyMap lists more than 64 buttons");
+
+// Smallest unsigned type with a bit per logical button
+template <bool fits16, bool fits32>
+struct ButtonMaskFor {
+  typedef uint64_t type;
+};
+
+template <bool fits32>
+struct ButtonMaskFor<true, fits32> {
+  typedef uint16_t type;
+};
+
+template <>
+struct ButtonMaskFor<false, true> {
+  typedef uint32_t type;
+};
+
+typedef ButtonMaskFor<(numButtons <= 16), (numButtons <= 32)>::type ButtonMask;
+
+// Bit n set = logical button n held down during the last scan
+ButtonMask buttonSnapshot = 0;
+
+#if INPUT_BACKEND == INPUT_GPIO
+
+// Port input registers, in the order they are sampled
+enum InputPort {
+  INPUT_PORT_B = 0,
+  INPUT_PORT_C = 1,
+  INPUT_PORT_D = 2,
+  INPUT_PORT_E = 3,
+  INPUT_PORT_F = 4,
+  INPUT_PORT_COUNT = 5
+};
+
+// Arduino Leonardo / Pro Micro digital pin -> port and bit (pins 0-23, A0 = 18)
+constexpr uint8_t leonardoPinPort[24] = {
+  INPUT_PORT_D, INPUT_PORT_D, INPUT_PORT_D, INPUT_PORT_D, // 0-3
+  INPUT_PORT_D, INPUT_PORT_C, INPUT_PORT_D, INPUT_PORT_E, // 4-7
+  INPUT_PORT_B, INPUT_PORT_B, INPUT_PORT_B, INPUT_PORT_B, // 8-11
+  INPUT_PORT_D, INPUT_PORT_C, INPUT_PORT_B, INPUT_PORT_B, // 12-15
+  INPUT_PORT_B, INPUT_PORT_B, INPUT_PORT_F, INPUT_PORT_F, // 16-19
+  INPUT_PORT_F, INPUT_PORT_F, INPUT_PORT_F, INPUT_PORT_F  // 20-23
+};
+constexpr uint8_t leonardoPinBit[24] = {
+  2, 3, 1, 0, 4, 6, 7, 6, 4, 5, 6, 7, 6, 7, 3, 1, 2, 0, 7, 6, 5, 4, 1, 0
+};
+
+constexpr uint8_t buttonPort(int index) {
+  return leonardoPinPort[keyMap[index]];
+}
+
+constexpr uint8_t buttonMask(int index) {
+  return 1 << leonardoPinBit[keyMap[index]];
+}
+
+// Unrolled at compile time: one AND and one OR per button, no table lookups
+template <int index>
+struct ButtonGather {
+  static_assert(keyMap[index] < 24, "Button pin has no port mapping");
+
+  static inline ButtonMask read(const uint8_t* ports) {
+    // Buttons pull to GND, so a clear bit means pressed
+    ButtonMask pressed = (ports[buttonPort(index)] & buttonMask(index)) ? 0 : ((ButtonMask)1 << index);
+    return pressed | ButtonGather<index - 1>::read(ports);
+  }
+};
+
+template <>
+struct ButtonGather<-1> {
+  static inline ButtonMask read(const uint8_t*) {
+    return 0;
+  }
+};
+
+// Port B buttons also raise a pin-change interrupt (PCINT0-7), which
+// wakes the MCU from idle sleep and scans at once (scanner.h)
+constexpr uint8_t buttonPinChangeMask(int index = 0) {
+  return index == numButtons ? 0 :
+    (buttonPort(index) == INPUT_PORT_B ? buttonMask(index) : 0) | buttonPinChangeMask(index + 1);
+}
+
+const uint8_t inputPinChangeMask = buttonPinChangeMask();
+
+void startInputs() {
+  for (int i = 0; i < numButtons; i++) {
+    pinMode(keyMap[i], INPUT_PULLUP);
+  }
+}
+
+// === INPUT CAPTURE ===
+void scanButtons() {
+  // Latch every port back to back so all buttons are sampled together
+  uint8_t ports[INPUT_PORT_COUNT];
+  ports[INPUT_PORT_B] = PINB;
+  ports[INPUT_PORT_C] = PINC;
+  ports[INPUT_PORT_D] = PIND;
+  ports[INPUT_PORT_E] = PINE;
+  ports[INPUT_PORT_F] = PINF;
+
+  buttonSnapshot = ButtonGather<numButtons - 1>::read(ports);
+}
+
+void serviceInputExpanders() {
+}
+
+#else
+
+#if INPUT_BACKEND == INPUT_SHIFT_REGISTER
+const uint8_t inputLineBytes = shiftRegisterCount;
+#else
+const uint8_t inputLineBytes = expanderCount * 2;
+#endif
+
+// No button line reaches a pin-change pin; the scan tick wakes the MCU
+const uint8_t inputPinChangeMask = 0;
+
+// Snapshot bytes, least significant first: the gather writes whole bytes
+// so a 64-bit mask costs no 64-bit shifts
+union ButtonMaskBytes {
+  ButtonMask mask;
+  uint8_t bytes[sizeof(ButtonMask)];
+};
+
+// Unrolled at compile time: one bit test and one byte OR per button
+template <int index>
+struct LineGather {
+  static_assert(keyMap[index] < inputLineBytes * 8, "Button is mapped past the last input line");
+
+  static inline void read(const uint8_t* lines, uint8_t* pressed) {
+    // Buttons pull their line to GND, so a clear bit means pressed
+    if (!(lines[keyMap[index] / 8] & (1 << (keyMap[index] % 8)))) {
+      pressed[index / 8] |= 1 << (index % 8);
+    }
+    LineGather<index - 1>::read(lines, pressed);
+  }
+};
+
+template <>
+struct LineGather<-1> {
+  static inline void read(const uint8_t*, uint8_t*) {
+  }
+};
+
+ButtonMask gatherLines(const uint8_t* lines) {
+  ButtonMaskBytes pressed;
+  pressed.mask = 0;
+  LineGather<numButtons - 1>::read(lines, pressed.bytes);
+  return pressed.mask;
+}
+
+#if INPUT_BACKEND == INPUT_SHIFT_REGISTER
+
+volatile uint8_t* shiftLoadPort;
+uint8_t shiftLoadMask;
+
+void startInputs() {
+  pinMode(shiftLoadPin, OUTPUT);
+  digitalWrite(shiftLoadPin, HIGH);
+  shiftLoadPort = portOutputRegister(digitalPinToPort(shiftLoadPin));
+  shiftLoadMask = digitalPinToBitMask(shiftLoadPin);
+
+  // SPI master, mode 0, LSB first, 16 MHz / 2; SS (PB0) must be an output
+  // or the SPI drops into slave mode
+  DDRB |= _BV(DDB0) | _BV(DDB1) | _BV(DDB2);
+  SPCR = _BV(SPE) | _BV(MSTR) | _BV(DORD);
+  SPSR = _BV(SPI2X);
+}
+
+// === INPUT CAPTURE ===
+void scanButtons() {
+  // A low pulse on SH/LD latches every register's inputs at the same time
+  *shiftLoadPort &= ~shiftLoadMask;
+  *shiftLoadPort |= shiftLoadMask;
+
+  // Then the whole chain comes out in one burst, a byte per register
+  uint8_t lines[inputLineBytes];
+  for (uint8_t i = 0; i < inputLineBytes; i++) {
+    SPDR = 0;
+    while (!(SPSR & _BV(SPIF))) {
+    }
+    lines[i] = SPDR;
+  }
+
+  buttonSnapshot = gatherLines(lines);
+}
+
+void serviceInputExpanders() {
+}
+
+#else
+
+#define MCP23017_GPPUA 0x0C
+#define MCP23017_GPIOA 0x12
+
+// Latest burst, written by loop() and read by the scan interrupt
+uint8_t expanderLines[inputLineBytes];
+unsigned long lastExpanderRead = 0;
+
+void startInputs() {
+  memset(expanderLines, 0xFF, sizeof(expanderLines));
+
+  Wire.begin();
+  Wire.setClock(displayI2CClock);
+
+  // Inputs after reset; turn on the pull-ups of both ports (GPPUA, GPPUB)
+  for (uint8_t i = 0; i < expanderCount; i++) {
+    Wire.beginTransmission(expanderAddress + i);
+    Wire.write((uint8_t)MCP23017_GPPUA);
+    Wire.write((uint8_t)0xFF);
+    Wire.write((uint8_t)0xFF);
+    if (Wire.endTransmission() != 0) {
+      Serial.print(F("MCP23017 not found at 0x"));
+      Serial.println(expanderAddress + i, 16);
+    }
+  }
+}
+
+// === INPUT CAPTURE (LOOP CONTEXT) ===
+void serviceInputExpanders() {
+  if (micros() - lastExpanderRead < expanderReadInterval) {
+    return;
+  }
+  lastExpanderRead = micros();
+
+  // GPIOA then GPIOB of each expander, read back to back
+  uint8_t lines[inputLineBytes];
+  for (uint8_t i = 0; i < expanderCount; i++) {
+    lines[2 * i] = 0xFF;
+    lines[2 * i + 1] = 0xFF;
+
+    Wire.beginTransmission(expanderAddress + i);
+    Wire.write((uint8_t)MCP23017_GPIOA);
+    if (Wire.endTransmission(false) == 0 && Wire.requestFrom((uint8_t)(expanderAddress + i), (uint8_t)2) == 2) {
+      lines[2 * i] = Wire.read();
+      lines[2 * i + 1] = Wire.read();
+    }
+  }
+
+  noInterrupts();
+  memcpy(expanderLines, lines, sizeof(lines));
+  interrupts();
+}
+
+// === INPUT CAPTURE (INTERRUPT CONTEXT) ===
+void scanButtons() {
+  buttonSnapshot = gatherLines(expanderLines);
+}
+
+#endif
+
+#endif
+
+#endif // INPUT_H
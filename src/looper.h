@@ -0,0 +1,770 @@
+/*
+ * looper.h - Phrase Looper
+ * 
+ * This file records what the note, drum and keyboard handlers play and
+ * loops it back. The first take sets the loop length; each overdub after
+ * it is a new layer of one loop cycle, and undo drops the newest layer.
+ * With quantize on, note-ons land on the nearest sixteenth of the tempo
+ * the arpeggiator follows (MIDI clock or its internal BPM).
+ * 
+ * Events live in one looperBufferSize byte buffer, layer after layer, each
+ * layer a time-ordered stream starting at the loop position it was
+ * recorded from:
+ *   <delta> <note> <target>
+ * delta is the time in ms since the previous event of the layer, 7 bits a
+ * byte with the top bit set on all but the last byte; note has the on/off
+ * flag in its top bit; target is the logical button, which picks the
+ * routing layers on playback (routing.h), or the drums flag for
+ * drumChannel. A typical event takes 3 bytes.
+ * 
+ * Playback is scheduled from the 1 kHz Timer1 interrupt like arpeggiator
+ * steps: the ISR walks each layer's cursor and queues due events, which
+ * loop() sends from the same places as the steps, so display transfers
+ * don't delay them. The delay from an event falling due to its note
+ * reaching USB is the "looper" telemetry stage (STATS).
+ * 
+ * Mode + sharp records (first take, then overdub), mode + octave down
+ * undoes, mode + octave up plays and stops, mode + note 5 toggles
+ * quantize and mode + note 6 saves the loop to the EEPROM past the
+ * presets, where it is reloaded from at boot.
+ */
+
+#ifndef LOOPER_H
+#define LOOPER_H
+
+enum LooperState {
+  LOOPER_EMPTY = 0,
+  LOOPER_RECORDING = 1,     // First take: the loop length isn't known yet
+  LOOPER_STOPPED = 2,
+  LOOPER_PLAYING = 3,
+  LOOPER_OVERDUBBING = 4
+};
+
+struct __attribute__((packed)) LooperLayer {
+  uint8_t end;        // Buffer offset past its last event; it starts where the previous ends
+  uint16_t start;     // Loop position of its first tick
+};
+
+// Where the timer interrupt is in a layer: the next event's note byte and
+// ticks until it falls due
+struct LooperCursor {
+  uint8_t offset;
+  uint16_t wait;
+};
+
+// An event the timer found due, stamped with micros() at that tick
+struct LooperEvent {
+  uint8_t layer;
+  uint8_t note;
+  uint8_t target;
+  unsigned long due;
+};
+
+// A note the loop holds, released by its layer's matching note-off
+struct LooperNote {
+  uint8_t layer;
+  uint8_t note;
+  uint8_t target;
+};
+
+const uint8_t looperNoteOn = 0x80;
+const uint8_t looperDrumTarget = 0x40;
+const uint8_t looperMaxEventSize = 5;   // 3-byte delta, note and target
+
+static_assert(numButtons <= looperDrumTarget, "Button numbers must leave the target's drums bit free");
+
+// Saved loop, from presetEepromSize: header, layer table, then the events
+struct __attribute__((packed)) LooperHeader {
+  uint8_t magic[2];
+  uint8_t version;
+  uint8_t layerCount;
+  uint16_t length;
+  uint8_t used;        // Event bytes stored
+  uint8_t crc;         // CRC-8 over the fields above, the layer table and the events
+};
+
+const uint8_t looperFormatVersion = 1;
+const uint8_t looperMagic0 = 'L';
+const uint8_t looperMagic1 = 'P';
+
+const uint16_t looperHeaderAddress = presetEepromSize;
+const uint16_t looperLayersAddress = looperHeaderAddress + sizeof(LooperHeader);
+const uint16_t looperDataAddress = looperLayersAddress + looperMaxLayers * sizeof(LooperLayer);
+
+static_assert(looperDataAddress + looperBufferSize <= 1024, "The saved loop does not fit in the EEPROM");
+
+// Function declarations
+void looperTimerTick();
+void queueLooperEvent(uint8_t layer, uint8_t offset);
+uint16_t decodeLooperDelta(uint8_t& offset);
+uint8_t looperLayerBegin(uint8_t layer);
+void serviceLooper();
+void serviceLooperRecording();
+void playLooperEvent(const LooperEvent& event);
+void looperRecord(uint8_t button, uint8_t note, bool on, bool drums);
+bool appendLooperEvent(uint16_t time, uint8_t note, uint8_t target, uint8_t reserve);
+uint16_t looperRecordTime();
+uint16_t quantizeLooperTime(uint16_t time);
+uint16_t looperQuantizeStep();
+void releaseLooperHolds(uint16_t time);
+void startLooperTake();
+void finishLooperTake();
+void startLooperOverdub();
+void finishLooperOverdub(bool nextCycle);
+void seekLooperLayer(uint8_t layer, uint16_t nextTime, bool skipPast);
+void startLooperPlayback();
+void stopLooperPlayback();
+void releaseLooperNotes(uint8_t fromLayer);
+void silenceLooper();
+void handleLooperRecordButton();
+void handleLooperUndoButton();
+void handleLooperPlayButton();
+void handleLooperQuantizeButton();
+void handleLooperSaveButton();
+void loadLooperStorage();
+void startLooperSave();
+void serviceLooperStorage();
+uint8_t looperCrc(uint8_t crc, const uint8_t* data, uint8_t length);
+
+// External variables needed for the looper
+extern uint8_t buttonNotes[];
+extern unsigned long arpClockPeriod;
+
+uint8_t looperState = LOOPER_EMPTY;
+bool looperQuantize = false;
+
+// Encoded events and the layers published to the timer interrupt; a layer
+// is only written before looperLayerCount takes it in
+uint8_t looperBuffer[looperBufferSize];
+LooperLayer looperLayers[looperMaxLayers];
+volatile uint8_t looperLayerCount = 0;
+uint16_t looperLength = 0;              // ms, 0 until the first take ends
+
+// Playback: the interrupt owns these while looperPlaying is set
+LooperCursor looperCursors[looperMaxLayers];
+volatile bool looperPlaying = false;
+volatile uint16_t looperPosition = 0;   // ms into the loop, at the last tick
+volatile uint16_t looperTicks = 0;      // Free-running, times the recording
+
+// Due events: the ISR only writes looperEventTail, loop() only looperEventHead
+LooperEvent looperEvents[looperEventQueueSize];
+volatile uint8_t looperEventHead = 0;
+volatile uint8_t looperEventTail = 0;
+volatile uint16_t looperEventOverflows = 0;
+
+LooperNote looperSounding[looperMaxSounding];
+uint8_t looperSoundingCount = 0;
+
+// Layer being recorded: its bytes run from the last published layer's end
+uint8_t looperRecordEnd = 0;
+uint16_t looperRecordStart = 0;         // looperTicks at its time 0
+uint16_t looperRecordPosition = 0;      // Loop position at its time 0
+uint16_t looperLastTime = 0;            // Of its newest event
+
+// Buttons whose note-on is in the recording but not their note-off yet
+ButtonMask looperHeld = 0;
+ButtonMask looperHeldDrums = 0;
+uint8_t looperHeldCount = 0;
+
+// Save in progress: layer table, events, then the header, a byte per pass
+LooperHeader looperSaveHeader;
+bool looperSaving = false;
+uint16_t looperSaveIndex = 0;
+
+// === PLAYBACK SCHEDULER (INTERRUPT CONTEXT) ===
+void looperTimerTick() {
+  looperTicks++;
+  if (!looperPlaying) {
+    return;
+  }
+
+  uint16_t position = looperPosition + 1;
+  if (position == looperLength) {
+    position = 0;
+  }
+  looperPosition = position;
+
+  for (uint8_t layer = 0; layer < looperLayerCount; layer++) {
+    LooperCursor& cursor = looperCursors[layer];
+    uint8_t end = looperLayers[layer].end;
+
+    if (position == looperLayers[layer].start) {
+      // The layer's cycle starts over
+      cursor.offset = looperLayerBegin(layer);
+      cursor.wait = cursor.offset < end ? decodeLooperDelta(cursor.offset) : 0;
+    } else if (cursor.offset < end) {
+      cursor.wait--;
+    }
+
+    while (cursor.offset < end && cursor.wait == 0) {
+      queueLooperEvent(layer, cursor.offset);
+      cursor.offset += 2;
+      if (cursor.offset < end) {
+        cursor.wait = decodeLooperDelta(cursor.offset);
+      }
+    }
+  }
+}
+
+void queueLooperEvent(uint8_t layer, uint8_t offset) {
+  uint8_t next = (looperEventTail + 1) & (looperEventQueueSize - 1);
+  if (next == looperEventHead) {
+    looperEventOverflows++;
+    return;
+  }
+
+  LooperEvent& event = looperEvents[looperEventTail];
+  event.layer = layer;
+  event.note = looperBuffer[offset];
+  event.target = looperBuffer[offset + 1];
+  event.due = micros();
+  looperEventTail = next;
+}
+
+// Reads a delta and leaves offset on the event's note byte
+uint16_t decodeLooperDelta(uint8_t& offset) {
+  uint16_t delta = 0;
+  uint8_t shift = 0;
+  uint8_t byte;
+  do {
+    byte = looperBuffer[offset++];
+    delta |= (uint16_t)(byte & 0x7F) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return delta;
+}
+
+uint8_t looperLayerBegin(uint8_t layer) {
+  return layer == 0 ? 0 : looperLayers[layer - 1].end;
+}
+
+// === EVENT DISPATCH (LOOP CONTEXT) ===
+void serviceLooper() {
+  serviceLooperRecording();
+
+  if (looperEventHead == looperEventTail) {
+    return;
+  }
+
+  unsigned long oldest = looperEvents[looperEventHead].due;
+  while (looperEventHead != looperEventTail) {
+    playLooperEvent(looperEvents[looperEventHead]);
+    looperEventHead = (looperEventHead + 1) & (looperEventQueueSize - 1);
+  }
+
+  flushMidiQueue();
+  recordStage(STAGE_LOOPER, micros() - oldest);
+}
+
+// A take or overdub cycle can run out between presses
+void serviceLooperRecording() {
+  if (looperState == LOOPER_RECORDING && looperRecordTime() >= looperMaxLength) {
+    finishLooperTake();
+    startLooperPlayback();
+  } else if (looperState == LOOPER_OVERDUBBING) {
+    noInterrupts();
+    uint16_t elapsed = looperTicks - looperRecordStart;
+    interrupts();
+    if (elapsed >= looperLength) {
+      finishLooperOverdub(true);
+    }
+  }
+}
+
+void playLooperEvent(const LooperEvent& event) {
+  // Queued before its layer was undone
+  if (event.layer >= looperLayerCount) {
+    return;
+  }
+
+  uint8_t note = event.note & 0x7F;
+  uint8_t button = event.target & (looperDrumTarget - 1);
+  bool drums = event.target & looperDrumTarget;
+
+  if (event.note & looperNoteOn) {
+    if (looperSoundingCount == looperMaxSounding) {
+      return;
+    }
+    LooperNote& sounding = looperSounding[looperSoundingCount++];
+    sounding.layer = event.layer;
+    sounding.note = note;
+    sounding.target = event.target;
+  } else {
+    uint8_t i = 0;
+    while (i < looperSoundingCount && (looperSounding[i].layer != event.layer ||
+           looperSounding[i].note != note || looperSounding[i].target != event.target)) {
+      i++;
+    }
+    if (i == looperSoundingCount) {
+      return;   // Skipped when it started, or silenced since
+    }
+    looperSounding[i] = looperSounding[--looperSoundingCount];
+  }
+
+  if (drums) {
+    if (event.note & looperNoteOn) {
+      playNote(drumChannel, note, 127);
+    } else {
+      releaseNote(drumChannel, note);
+    }
+  } else if (event.note & looperNoteOn) {
+    playRoutedNote(button, note, 127);
+  } else {
+    releaseRoutedNote(button, note);
+  }
+}
+
+// === RECORDING (LOOP CONTEXT) ===
+// Called by the handlers for every note they play or release
+void looperRecord(uint8_t button, uint8_t note, bool on, bool drums) {
+  // Close a take or overdub cycle that ran out since the last loop() pass first
+  serviceLooperRecording();
+  if (looperState != LOOPER_RECORDING && looperState != LOOPER_OVERDUBBING) {
+    return;
+  }
+
+  ButtonMask bit = (ButtonMask)1 << button;
+  uint8_t target = button | (drums ? looperDrumTarget : 0);
+  uint16_t time = looperRecordTime();
+
+  if (on) {
+    if (looperHeld & bit) {
+      return;
+    }
+    if (looperQuantize) {
+      time = quantizeLooperTime(time);
+    }
+    // Leave room for the note-offs of every held note, this one included
+    if (!appendLooperEvent(time, note | looperNoteOn, target, (looperHeldCount + 1) * looperMaxEventSize)) {
+      showGlyphs(GLYPH_LOOP_FULL);
+      return;
+    }
+    looperHeld |= bit;
+    if (drums) {
+      looperHeldDrums |= bit;
+    }
+    looperHeldCount++;
+  } else if (looperHeld & bit) {
+    appendLooperEvent(time, note, target, 0);
+    looperHeld &= ~bit;
+    looperHeldDrums &= ~bit;
+    looperHeldCount--;
+  }
+}
+
+bool appendLooperEvent(uint16_t time, uint8_t note, uint8_t target, uint8_t reserve) {
+  uint16_t delta = time - looperLastTime;
+  uint8_t size = (delta < 0x80 ? 1 : delta < 0x4000 ? 2 : 3) + 2;
+  if (looperRecordEnd + size + reserve > looperBufferSize) {
+    return false;
+  }
+
+  while (delta >= 0x80) {
+    looperBuffer[looperRecordEnd++] = (delta & 0x7F) | 0x80;
+    delta >>= 7;
+  }
+  looperBuffer[looperRecordEnd++] = delta;
+  looperBuffer[looperRecordEnd++] = note;
+  looperBuffer[looperRecordEnd++] = target;
+  looperLastTime = time;
+  return true;
+}
+
+// ms since the recording layer's time 0; events never go back in time, and
+// an overdub's stay inside its cycle
+uint16_t looperRecordTime() {
+  noInterrupts();
+  uint16_t time = looperTicks - looperRecordStart;
+  interrupts();
+
+  if (looperState == LOOPER_OVERDUBBING && time >= looperLength) {
+    time = looperLength - 1;
+  }
+  return max(time, looperLastTime);
+}
+
+// To the nearest step counted from the loop's start; moving later than the
+// next event recorded is fine, as that one is clamped after it
+uint16_t quantizeLooperTime(uint16_t time) {
+  uint16_t step = looperQuantizeStep();
+  uint16_t offset = ((uint32_t)looperRecordPosition + time) % step;
+  long quantized = offset < step / 2 ? (long)time - offset : (long)time + step - offset;
+
+  if (quantized < looperLastTime) {
+    quantized = looperLastTime;
+  }
+  if (looperState == LOOPER_OVERDUBBING && quantized >= looperLength) {
+    quantized = looperLength - 1;
+  }
+  return quantized;
+}
+
+// A sixteenth in ms, from the host clock while the arpeggiator follows it
+uint16_t looperQuantizeStep() {
+  if (arpFollowingClock() && arpClockPeriod > 0) {
+    return max(1UL, arpClockPeriod * (midiClocksPerBeat / arpStepsPerBeat) / 1000);
+  }
+  return 60000UL / (arpBpm * arpStepsPerBeat);
+}
+
+// Ends every held note in the recording, so no layer leaves one sounding
+void releaseLooperHolds(uint16_t time) {
+  ButtonMask bit = 1;
+  for (uint8_t i = 0; looperHeld != 0; i++, bit <<= 1) {
+    if (!(looperHeld & bit)) {
+      continue;
+    }
+    bool drums = looperHeldDrums & bit;
+    appendLooperEvent(time, buttonNotes[i], i | (drums ? looperDrumTarget : 0), 0);
+    looperHeld &= ~bit;
+  }
+  looperHeldDrums = 0;
+  looperHeldCount = 0;
+}
+
+void startLooperTake() {
+  noInterrupts();
+  looperRecordStart = looperTicks;
+  interrupts();
+
+  looperRecordPosition = 0;
+  looperRecordEnd = 0;
+  looperLastTime = 0;
+  looperState = LOOPER_RECORDING;
+}
+
+// The take's length is the time it ran, to the nearest step with quantize
+void finishLooperTake() {
+  uint16_t time = looperRecordTime();
+  releaseLooperHolds(time);
+
+  if (looperRecordEnd == 0) {
+    looperState = LOOPER_EMPTY;   // Nothing was played
+    return;
+  }
+
+  uint16_t length = time + 1;
+  if (looperQuantize) {
+    uint16_t step = looperQuantizeStep();
+    length = max((uint16_t)((time + step / 2) / step * step), step);
+  }
+  looperLength = max(length, (uint16_t)(looperLastTime + 1));
+
+  looperLayers[0].end = looperRecordEnd;
+  looperLayers[0].start = 0;
+  looperLayerCount = 1;
+  looperState = LOOPER_STOPPED;
+  if (looperSaving) {
+    startLooperSave();
+  }
+}
+
+// Records a layer from the current position, over one loop cycle
+void startLooperOverdub() {
+  if (looperLayerCount == looperMaxLayers) {
+    showGlyphs(GLYPH_LOOP_FULL);
+    return;
+  }
+
+  noInterrupts();
+  looperRecordStart = looperTicks;
+  looperRecordPosition = looperPosition;
+  interrupts();
+
+  looperRecordEnd = looperLayers[looperLayerCount - 1].end;
+  looperLastTime = 0;
+  looperState = LOOPER_OVERDUBBING;
+}
+
+// Publishes the overdub layer. At the end of its cycle (nextCycle) the
+// notes still held carry over into a new layer, recorded from where this
+// one started.
+void finishLooperOverdub(bool nextCycle) {
+  ButtonMask held = looperHeld;
+  ButtonMask heldDrums = looperHeldDrums;
+  releaseLooperHolds(looperRecordTime());
+
+  uint8_t layer = looperLayerCount;
+  if (looperRecordEnd > looperLayerBegin(layer)) {
+    looperLayers[layer].end = looperRecordEnd;
+    looperLayers[layer].start = looperRecordPosition;
+
+    noInterrupts();
+    uint16_t elapsed = looperTicks - looperRecordStart;
+    if (elapsed >= looperLength) {
+      // Its first ticks have already gone by: send them late, not a cycle late
+      seekLooperLayer(layer, elapsed - looperLength + 1, false);
+    } else {
+      seekLooperLayer(layer, elapsed + 1, true);
+    }
+    looperLayerCount = layer + 1;
+    interrupts();
+
+    if (looperSaving) {
+      startLooperSave();
+    }
+  }
+
+  looperState = LOOPER_PLAYING;
+  if (!nextCycle || looperLayerCount == looperMaxLayers) {
+    return;
+  }
+
+  looperRecordStart += looperLength;
+  looperRecordEnd = looperLayers[looperLayerCount - 1].end;
+  looperLastTime = 0;
+  looperState = LOOPER_OVERDUBBING;
+
+  ButtonMask bit = 1;
+  for (uint8_t i = 0; held != 0; i++, bit <<= 1) {
+    if (held & bit) {
+      looperRecord(i, buttonNotes[i], true, heldDrums & bit);
+      held &= ~bit;
+    }
+  }
+}
+
+// Points a layer's cursor at its first event from nextTime on, for the
+// next tick; with skipPast clear, earlier events fall due on that tick.
+// Called with interrupts off.
+void seekLooperLayer(uint8_t layer, uint16_t nextTime, bool skipPast) {
+  LooperCursor& cursor = looperCursors[layer];
+  uint8_t end = looperLayers[layer].end;
+  uint16_t time = 0;
+
+  cursor.offset = looperLayerBegin(layer);
+  while (cursor.offset < end) {
+    time += decodeLooperDelta(cursor.offset);
+    if (time >= nextTime || !skipPast) {
+      cursor.wait = time >= nextTime ? time - nextTime + 1 : 1;
+      return;
+    }
+    cursor.offset += 2;
+  }
+}
+
+// === TRANSPORT ===
+// From the top of the loop, with overdubs that wrap past it picked up
+// part-way through
+void startLooperPlayback() {
+  if (looperLayerCount == 0) {
+    return;
+  }
+
+  noInterrupts();
+  looperPosition = looperLength - 1;
+  for (uint8_t layer = 0; layer < looperLayerCount; layer++) {
+    seekLooperLayer(layer, looperLength - looperLayers[layer].start, true);
+  }
+  looperPlaying = true;
+  interrupts();
+
+  looperState = LOOPER_PLAYING;
+}
+
+void stopLooperPlayback() {
+  noInterrupts();
+  looperPlaying = false;
+  looperEventHead = looperEventTail;
+  interrupts();
+
+  releaseLooperNotes(0);
+  flushMidiQueue();
+  looperState = looperLayerCount > 0 ? LOOPER_STOPPED : LOOPER_EMPTY;
+}
+
+void releaseLooperNotes(uint8_t fromLayer) {
+  uint8_t kept = 0;
+  for (uint8_t i = 0; i < looperSoundingCount; i++) {
+    const LooperNote& sounding = looperSounding[i];
+    if (sounding.layer < fromLayer) {
+      looperSounding[kept++] = sounding;
+    } else if (sounding.target & looperDrumTarget) {
+      releaseNote(drumChannel, sounding.note);
+    } else {
+      releaseRoutedNote(sounding.target & (looperDrumTarget - 1), sounding.note);
+    }
+  }
+  looperSoundingCount = kept;
+}
+
+// Called by stopAllPlayingNotes() before it clears buttonNotes: held recorded
+// notes take their note-off from buttonNotes. Loop notes are just forgotten,
+// since stopAllPlayingNotes() then silences every sounding note itself
+void silenceLooper() {
+  if (looperHeld != 0) {
+    releaseLooperHolds(looperRecordTime());
+  }
+  looperSoundingCount = 0;
+}
+
+// === FUNCTION BUTTONS (MODE HELD) ===
+// Record: a first take, then overdubs while playing; again ends them
+void handleLooperRecordButton() {
+  switch (looperState) {
+    case LOOPER_EMPTY:
+      startLooperTake();
+      showGlyphs(GLYPH_LOOP_REC);
+      break;
+    case LOOPER_RECORDING:
+      finishLooperTake();
+      startLooperPlayback();
+      showGlyphs(looperState == LOOPER_PLAYING ? GLYPH_LOOP_PLAY : GLYPH_LOOP_STOP);
+      break;
+    case LOOPER_STOPPED:
+      startLooperPlayback();
+      startLooperOverdub();
+      showGlyphs(GLYPH_LOOP_DUB);
+      break;
+    case LOOPER_PLAYING:
+      startLooperOverdub();
+      showGlyphs(GLYPH_LOOP_DUB);
+      break;
+    case LOOPER_OVERDUBBING:
+      finishLooperOverdub(false);
+      showGlyphs(GLYPH_LOOP_PLAY);
+      break;
+  }
+}
+
+// Undo: drops the layer being recorded, and the newest one too if nothing
+// has been recorded into it yet (an overdub carries on into new cycles)
+void handleLooperUndoButton() {
+  looperHeld = 0;
+  looperHeldDrums = 0;
+  looperHeldCount = 0;
+
+  if (looperState == LOOPER_RECORDING) {
+    looperState = LOOPER_EMPTY;
+    showGlyphs(GLYPH_LOOP_UNDO);
+    return;
+  }
+  if (looperState == LOOPER_OVERDUBBING) {
+    looperState = LOOPER_PLAYING;
+    if (looperRecordEnd > looperLayerBegin(looperLayerCount)) {
+      showGlyphs(GLYPH_LOOP_UNDO);
+      return;
+    }
+  }
+
+  if (looperLayerCount == 0) {
+    return;
+  }
+
+  uint8_t layer = looperLayerCount - 1;
+  looperLayerCount = layer;
+  releaseLooperNotes(layer);
+  flushMidiQueue();
+  if (layer == 0) {
+    stopLooperPlayback();
+  }
+  if (looperSaving) {
+    startLooperSave();
+  }
+  showGlyphs(GLYPH_LOOP_UNDO);
+}
+
+void handleLooperPlayButton() {
+  if (looperState == LOOPER_RECORDING) {
+    finishLooperTake();
+  } else if (looperState == LOOPER_OVERDUBBING) {
+    finishLooperOverdub(false);
+  }
+
+  if (looperState == LOOPER_PLAYING) {
+    stopLooperPlayback();
+    showGlyphs(GLYPH_LOOP_STOP);
+  } else if (looperState == LOOPER_STOPPED) {
+    startLooperPlayback();
+    showGlyphs(GLYPH_LOOP_PLAY);
+  }
+}
+
+void handleLooperQuantizeButton() {
+  looperQuantize = !looperQuantize;
+  showGlyphs(looperQuantize ? GLYPH_LOOP_QUANTIZE : GLYPH_LOOP_FREE);
+}
+
+// Not while recording: the layer table would change under the save
+void handleLooperSaveButton() {
+  if (looperState == LOOPER_RECORDING || looperState == LOOPER_OVERDUBBING) {
+    return;
+  }
+  startLooperSave();
+  showGlyphs(GLYPH_SAVED);
+}
+
+// === EEPROM ===
+uint8_t looperCrc(uint8_t crc, const uint8_t* data, uint8_t length) {
+  for (uint8_t i = 0; i < length; i++) {
+    crc = _crc8_ccitt_update(crc, data[i]);
+  }
+  return crc;
+}
+
+// Boot: restores the last saved loop, stopped
+void loadLooperStorage() {
+  LooperHeader header;
+  eeprom_read_block(&header, (const void*)looperHeaderAddress, sizeof(header));
+
+  if (header.magic[0] != looperMagic0 || header.magic[1] != looperMagic1 ||
+      header.version != looperFormatVersion || header.layerCount > looperMaxLayers ||
+      header.used > looperBufferSize || header.length == 0 || header.length > looperMaxLength) {
+    return;
+  }
+
+  eeprom_read_block(looperLayers, (const void*)looperLayersAddress, sizeof(looperLayers));
+  eeprom_read_block(looperBuffer, (const void*)looperDataAddress, header.used);
+
+  uint8_t crc = looperCrc(0, (const uint8_t*)&header, sizeof(header) - 1);
+  crc = looperCrc(crc, (const uint8_t*)looperLayers, sizeof(looperLayers));
+  crc = looperCrc(crc, looperBuffer, header.used);
+  if (crc != header.crc || (header.layerCount > 0 && looperLayers[header.layerCount - 1].end != header.used)) {
+    return;
+  }
+
+  looperLength = header.length;
+  looperLayerCount = header.layerCount;
+  looperState = looperLayerCount > 0 ? LOOPER_STOPPED : LOOPER_EMPTY;
+}
+
+// Starts over whenever the loop changes mid-save; the header goes last,
+// so an interrupted save leaves a loop that fails its CRC
+void startLooperSave() {
+  LooperHeader& header = looperSaveHeader;
+  header.magic[0] = looperMagic0;
+  header.magic[1] = looperMagic1;
+  header.version = looperFormatVersion;
+  header.layerCount = looperLayerCount;
+  header.length = looperLength;
+  header.used = looperLayerCount > 0 ? looperLayers[looperLayerCount - 1].end : 0;
+
+  uint8_t crc = looperCrc(0, (const uint8_t*)&header, sizeof(header) - 1);
+  crc = looperCrc(crc, (const uint8_t*)looperLayers, sizeof(looperLayers));
+  header.crc = looperCrc(crc, looperBuffer, header.used);
+
+  looperSaveIndex = 0;
+  looperSaving = true;
+}
+
+// One byte per loop() pass while the EEPROM is idle, like the presets
+void serviceLooperStorage() {
+  if (!looperSaving || !eeprom_is_ready()) {
+    return;
+  }
+
+  const uint16_t layersSize = sizeof(looperLayers);
+  uint16_t index = looperSaveIndex++;
+  if (index < layersSize) {
+    eeprom_update_byte((uint8_t*)(uintptr_t)(looperLayersAddress + index), ((const uint8_t*)looperLayers)[index]);
+  } else if (index < layersSize + looperSaveHeader.used) {
+    index -= layersSize;
+    eeprom_update_byte((uint8_t*)(uintptr_t)(looperDataAddress + index), looperBuffer[index]);
+  } else {
+    index -= layersSize + looperSaveHeader.used;
+    eeprom_update_byte((uint8_t*)(uintptr_t)(looperHeaderAddress + index), ((const uint8_t*)&looperSaveHeader)[index]);
+    looperSaving = index + 1 < (int)sizeof(LooperHeader);
+  }
+}
+
+#endif // LOOPER_H
@@ -5,10 +5,31 @@
  Files structure:
  - midi_controller_main.ino (this file)
  - config.h (pin definitions and constants)
+ - telemetry.h (hot-path timing statistics)
+ - input.h (button snapshot: GPIO, 74HC165 or MCP23017 backend)
+ - debounce.h (bitmask debounce engine)
+ - scanner.h (1 kHz timer interrupt scanner and event queue)
  - modes.h (mode definitions and enums)
+ - scales.h (bit-packed scale library)
+ - note_tables.h (compile-time note lookup tables)
+ - chords.h (configurator chord slots)
+ - presets.h (EEPROM preset banks)
+ - ssd1306.h (minimal OLED driver)
+ - font5x7.h (display font)
+ - glyph_cache.h (pre-rendered display text, generated)
+ - renderer.h (page-mode display list renderer)
  - display.h (display functions)
  - midi_functions.h (MIDI communication functions)
+ - active_notes.h (reference-counted active notes per channel)
+ - routing.h (split/layer output routing)
+ - arpeggiator.h (clock-synced arpeggiator)
+ - looper.h (phrase looper)
+ - chord_player.h (chord mode and strum)
  - button_handlers.h (button handling functions)
+ - sysex_config.h (SysEx configuration transport)
+ - midi_input.h (incoming USB MIDI)
+ - serial_commands.h (serial command processor)
+ - power.h (idle sleep between loop passes)
   
  Hardware connections:
  OLED Display (I2C):
@@ -23,184 +44,175 @@
  - Button 5: Pin 8;
  - Button 6: Pin 5;
  - Button 7: Pin 15;
- - Button 8: Pin 9;
- - Button 9: Pin 6;
+ - Button 8: Pin 6;
+ - Button 9: Pin 9;
  - Button 10: Pin 10;
  - Button 11: Pin 18 (A0);
 
+ With INPUT_BACKEND set to a shift register or MCP23017 backend, the
+ buttons come from expander lines instead (keyMap in config.h), and any
+ keys past the 11th form a chromatic keyboard.
+
   Mode Functions:
  - Standard Mode: C-D-E-F-G-A-B with sharp and octave controls
  - Scales Mode: Various scales with semitone transposition
  - Drums Mode: All 10 buttons play different drum sounds
+ - Arp Mode: Held scale notes arpeggiated, synced to MIDI clock; sharp
+   selects the pattern, octave buttons set the internal tempo
+ - Chords Mode: Each note button plays its configurator chord; sharp
+   flips the strum direction, octave buttons set the strum time
  */
 
 #include <MIDIUSB.h>
 #include <Wire.h>
-#include <Adafruit_GFX.h>
-#include <Adafruit_SSD1306.h>
 
 #include "config.h"
+#include "telemetry.h"
+#include "input.h"
+#include "debounce.h"
+#include "scanner.h"
 #include "modes.h"
+#include "scales.h"
+#include "note_tables.h"
+#include "chords.h"
+#include "presets.h"
+#include "ssd1306.h"
+#include "font5x7.h"
+#include "glyph_cache.h"
+#include "renderer.h"
 #include "display.h"
 #include "midi_functions.h"
+#include "active_notes.h"
+#include "routing.h"
+#include "arpeggiator.h"
+#include "looper.h"
+#include "chord_player.h"
 #include "button_handlers.h"
+#include "sysex_config.h"
+#include "midi_input.h"
+#include "serial_commands.h"
+#include "power.h"
 
 // Global variables
 ControllerMode currentMode = MODE_STANDARD;
-ScaleType currentScale = SCALE_MAJOR;
-
-// State variables
-bool noteStates[numNoteButtons];
-bool lastNoteStates[numNoteButtons];
-bool sharpState = false;
-bool lastSharpState = false;
-bool octaveDownState = false;
-bool lastOctaveDownState = false;
-bool octaveUpState = false;
-bool lastOctaveUpState = false;
-bool modeState = false;
-bool lastModeState = false;
+uint8_t currentScale = SCALE_MAJOR;   // Index into the scale library
 
 int currentOctave = 4;
 int octaveOffset = 0;
 int semitoneOffset = 0;
 
-int playedMidiNotes[numNoteButtons + 3]; // +3 for extra drum buttons
-bool noteIsPlaying[numNoteButtons + 3];
+uint8_t buttonNotes[numButtons]; // Note each button holds, noNote if none
 
-unsigned long lastDebounceTime[numNoteButtons + 4];
-
-String currentNote = "";
+uint8_t currentNoteGlyphs[2] = {noGlyph, noGlyph};  // Note or drum name shown on the display
 unsigned long displayTimeout = 0;
 
 unsigned long lastAnimationUpdate = 0;
 int animationFrame = 0;
 
-void setup() {
-  // Initialize OLED display
-  if(!display.begin(SSD1306_SWITCHCAPVCC, SCREEN_ADDRESS)) {
-    Serial.println(F("SSD1306 allocation failed"));
-    for(;;);
-  }
-  // Show startup message
-  startupDisplay();
+unsigned long lastButtonTime = 0;   // Stops the idle animation after a while
 
-  delay(2500);
-  
-  // Initialize button pins
-  for (int i = 0; i < numNoteButtons; i++) {
-    pinMode(notePins[i], INPUT_PULLUP);
-    noteStates[i] = HIGH;
-    lastNoteStates[i] = HIGH;
-    lastDebounceTime[i] = 0;
-    playedMidiNotes[i] = 0;
-    noteIsPlaying[i] = false;
-  }
+void setup() {
+  // Initialize serial
+  Serial.begin(9600);
   
-  // Initialize extra drum buttons
-  for (int i = numNoteButtons; i < numNoteButtons + 3; i++) {
-    playedMidiNotes[i] = 0;
-    noteIsPlaying[i] = false;
+  // Initialize button pins or expanders
+  startInputs();
+  for (int i = 0; i < numButtons; i++) {
+    buttonNotes[i] = noNote;
   }
   
-  pinMode(sharpPin, INPUT_PULLUP);
-  pinMode(octaveDownPin, INPUT_PULLUP);
-  pinMode(octaveUpPin, INPUT_PULLUP);
-  pinMode(modePin, INPUT_PULLUP);
-  
-  // Initialize states
-  sharpState = HIGH;
-  lastSharpState = HIGH;
-  octaveDownState = HIGH;
-  lastOctaveDownState = HIGH;
-  octaveUpState = HIGH;
-  lastOctaveUpState = HIGH;
-  modeState = HIGH;
-  lastModeState = HIGH;
-  
-  // Initialize debounce times
-  for (int i = 0; i < numNoteButtons + 4; i++) {
-    lastDebounceTime[i] = 0;
-  }
+  resetRouting();
   
-  // Initialize serial
-  Serial.begin(9600);
+  // Restore the last active preset (mode, scale, transpose, drums, chords)
+  loadPresetStorage();
+  loadLooperStorage();
+  
+  // Start sampling buttons from the timer interrupt
+  startButtonScanner();
+  
+  // Initialize OLED display; without one the controller still plays
+  if (!ssd1306Begin()) {
+    Serial.println(F("SSD1306 not found"));
+  }
   
-  // Show initial display
-  updateDisplay();
+  // Show startup message; it times out from loop() while notes already play
+  startupDisplay();
   
-  delay(100);
+  bootReadyTime = millis();
 }
 
 void loop() {
-  // Handle mode button
-  handleModeButton();
-  
-  // Handle other buttons based on current mode
-  if (currentMode == MODE_STANDARD) {
-    handleSharpButton();
-    handleOctaveButtons();
-    // Handle 7 note buttons
-    for (int i = 0; i < numNoteButtons; i++) {
-      handleNoteButton(i);
-    }
-  } else if (currentMode == MODE_SCALES) {
-    handleScaleButton();
-    handleTransposeButtons(); // Changed from octave to transpose
-    // Handle 7 note buttons
-    for (int i = 0; i < numNoteButtons; i++) {
-      handleNoteButton(i);
-    }
-  } else if (currentMode == MODE_DRUMS) {
-    // Handle all 10 buttons as drums
-    for (int i = 0; i < numNoteButtons; i++) {
-      handleNoteButton(i);
-    }
-    // Handle the 3 extra buttons (sharp, octave down, octave up) as drums
-    handleDrumButton(numNoteButtons, sharpPin);     // Button 8
-    handleDrumButton(numNoteButtons + 1, octaveDownPin); // Button 9
-    handleDrumButton(numNoteButtons + 2, octaveUpPin);   // Button 10
-  }
+  unsigned long loopStart = micros();
+  
+  trackBootMilestones();
   
-  // Handle all buttons based on current mode
-  updateButtons();
+  // Send arpeggiator steps and loop events the timer has scheduled, and
+  // strummed chord notes that are due
+  serviceArpeggiator();
+  serviceLooper();
+  serviceChords();
+  
+  // Read I2C expanders for the scanner (MCP23017 backend only)
+  serviceInputExpanders();
+  
+  // Dispatch every press/release the scanner has queued, once each
+  ButtonEvent event;
+  while (nextButtonEvent(event)) {
+    handleButtonEvent(event);
+    lastButtonTime = millis();
+  }
   
   // Check if display should timeout
   if (displayTimeout > 0 && millis() > displayTimeout) {
-    currentNote = "";
+    showGlyphs(noGlyph);
     displayTimeout = 0;
   }
   
-  // Update animation when idle
-  if (currentNote == "" && millis() - lastAnimationUpdate > ANIMATION_DELAY) {
-    int maxFrames = (currentMode == MODE_DRUMS) ? 10 : 7;
-    animationFrame = (animationFrame + 1) % maxFrames;
+#if SHOW_SPLASH
+  // Advance the splash screen, if it is still up
+  serviceSplash();
+#endif
+  
+  // Update animation when idle, until nobody has played for a while
+  if (!splashShowing() && currentNoteGlyphs[0] == noGlyph && millis() - lastAnimationUpdate > ANIMATION_DELAY &&
+      millis() - lastButtonTime < idleAnimationTimeout) {
+    stepIdleAnimation();
     lastAnimationUpdate = millis();
-    updateDisplay();
   }
   
-  delay(1);
+  // Send everything this pass produced in a single USB transfer
+  flushMidiQueue();
+  
+  // Events that produced no MIDI (octave, scale...) don't count as latency
+  scanLatencyPending = false;
+  
+  // Redraw what changed, streaming a bounded slice of the frame to the OLED
+  serviceDisplay();
+  
+  // Handle SysEx configuration requests from the host
+  pollMidiInput();
+  
+  // Handle STATS / STATS_RESET and other serial commands
+  pollSerialCommands();
+  
+  // Write pending preset and loop saves a byte at a time
+  servicePresetStorage();
+  serviceLooperStorage();
+  
+  recordStage(STAGE_LOOP, micros() - loopStart);
+  
+  // Sleep for a millisecond, still sending arpeggiator steps, loop events
+  // and strums as they fall due; a button event wakes the next pass straight away
+  idleUntilWork(loopIdlePeriod);
 }
 
 // Global variables that need to be accessible from other files
 extern ControllerMode currentMode;
-extern ScaleType currentScale;
-extern bool sharpState;
+extern uint8_t currentScale;
 extern int currentOctave;
 extern int octaveOffset;
 extern int semitoneOffset;
-extern String currentNote;
+extern uint8_t currentNoteGlyphs[];
 extern unsigned long displayTimeout;
 extern int animationFrame;
-extern int playedMidiNotes[];
-extern bool noteIsPlaying[];
-extern unsigned long lastDebounceTime[];
-extern bool noteStates[];
-extern bool lastNoteStates[];
-extern bool lastSharpState;
-extern bool octaveDownState;
-extern bool lastOctaveDownState;
-extern bool octaveUpState;
-extern bool lastOctaveUpState;
-extern bool modeState;
-extern bool lastModeState;
\ No newline at end of file
+extern uint8_t buttonNotes[];
\ No newline at end of file
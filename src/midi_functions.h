@@ -9,71 +9,139 @@
 #define MIDI_FUNCTIONS_H
 
 // Function declarations
+void queueMidiEvent(midiEventPacket_t event);
+void flushMidiQueue();
+void reserveMidiTransfer(uint8_t count);
+uint8_t midiQueueDepth();
 void sendMidiNoteOn(byte channel, byte note, byte velocity);
 void sendMidiNoteOff(byte channel, byte note, byte velocity);
 int calculateStandardMidiNote(int buttonIndex);
 int calculateScaleMidiNote(int buttonIndex);
 int calculateDrumMidiNote(int buttonIndex);
-void stopAllPlayingNotes();
+int calculateKeyboardMidiNote(int key);
+// Note: sharpHeld() is defined in button_handlers.h
+bool sharpHeld();
 
 // External variables needed for MIDI functions
 extern ControllerMode currentMode;
-extern ScaleType currentScale;
-extern bool sharpState;
+extern uint8_t currentScale;
 extern int octaveOffset;
 extern int semitoneOffset;
-extern int playedMidiNotes[];
-extern bool noteIsPlaying[];
+
+// === OUTGOING MIDI QUEUE ===
+// Events are collected here during a pass of loop() and handed to the USB
+// endpoint in one go by flushMidiQueue(), instead of one transfer per packet.
+midiEventPacket_t midiQueue[midiQueueSize];
+uint8_t midiQueueHead = 0;
+uint8_t midiQueueCount = 0;
+uint8_t midiQueueHighWater = 0;   // Deepest the queue has ever been
+uint16_t midiQueueOverflows = 0;  // Times the queue filled up and was flushed early
+
+void queueMidiEvent(midiEventPacket_t event) {
+  if (midiQueueCount == midiQueueSize) {
+    // Never drop a note-off: push what we have to the host and carry on
+    midiQueueOverflows++;
+    flushMidiQueue();
+  }
+
+  midiQueue[(midiQueueHead + midiQueueCount) & (midiQueueSize - 1)] = event;
+  midiQueueCount++;
+
+  if (midiQueueCount > midiQueueHighWater) {
+    midiQueueHighWater = midiQueueCount;
+  }
+}
+
+void flushMidiQueue() {
+  if (midiQueueCount == 0) {
+    return;
+  }
+
+  unsigned long start = micros();
+  uint8_t packetsInTransfer = 0;
+
+  while (midiQueueCount > 0) {
+    MidiUSB.sendMIDI(midiQueue[midiQueueHead]);
+    midiQueueHead = (midiQueueHead + 1) & (midiQueueSize - 1);
+    midiQueueCount--;
+
+    // Release the endpoint bank each time it holds a full 64 bytes
+    if (++packetsInTransfer == midiPacketsPerTransfer) {
+      MidiUSB.flush();
+      packetsInTransfer = 0;
+    }
+  }
+
+  if (packetsInTransfer > 0) {
+    MidiUSB.flush();
+  }
+
+  recordStage(STAGE_USB, micros() - start);
+  recordScanLatency();
+
+  if (firstMidiTime == 0) {
+    firstMidiTime = millis();
+  }
+}
+
+// Flushes first if count more packets would not fit in the transfer being
+// filled, so a press's packets always reach the host together
+void reserveMidiTransfer(uint8_t count) {
+  if (midiQueueCount % midiPacketsPerTransfer + count > midiPacketsPerTransfer) {
+    flushMidiQueue();
+  }
+}
+
+uint8_t midiQueueDepth() {
+  return midiQueueCount;
+}
 
 void sendMidiNoteOn(byte channel, byte note, byte velocity) {
-  midiEventPacket_t noteOn = {0x09, 0x90 | channel, note, velocity};
-  MidiUSB.sendMIDI(noteOn);
-  MidiUSB.flush();
+  unsigned long start = micros();
+  midiEventPacket_t noteOn = {0x09, (uint8_t)(0x90 | channel), note, velocity};
+  queueMidiEvent(noteOn);
+  recordStage(STAGE_NOTE, micros() - start);
 }
 
 void sendMidiNoteOff(byte channel, byte note, byte velocity) {
-  midiEventPacket_t noteOff = {0x08, 0x80 | channel, note, velocity};
-  MidiUSB.sendMIDI(noteOff);
-  MidiUSB.flush();
+  unsigned long start = micros();
+  midiEventPacket_t noteOff = {0x08, (uint8_t)(0x80 | channel), note, velocity};
+  queueMidiEvent(noteOff);
+  recordStage(STAGE_NOTE, micros() - start);
 }
 
+// Note lookups read the flash tables built in note_tables.h
 int calculateStandardMidiNote(int buttonIndex) {
-  int midiNote = baseNotes[buttonIndex] + (octaveOffset * 12);
-  
-  // Add sharp if sharp button is held
-  if (sharpState == LOW) {
-    midiNote += 1;
-  }
-  
-  return midiNote;
+  // Second index adds the sharp if the sharp button is held
+  return pgm_read_byte(&standardNoteTable[octaveOffset - minOctaveOffset][sharpHeld()][buttonIndex]);
 }
 
 int calculateScaleMidiNote(int buttonIndex) {
-  int rootNote = 60; // C4 (no octave offset for scales mode)
-  int interval = scaleIntervals[currentScale][buttonIndex];
-  
-  // Apply semitone transposition
-  return rootNote + interval + semitoneOffset;
+  // The transpose moves the root (no octave offset for scales mode)
+  return scaleNote(currentScale, scaleRootNote + semitoneOffset, buttonIndex);
 }
 
 int calculateDrumMidiNote(int buttonIndex) {
-  // Return the appropriate drum note based on button index
+  // Return the appropriate drum note from the active preset's drum map
   if (buttonIndex < 10) {
-    return drumNotes[buttonIndex];
+    return activePreset->drumNotes[buttonIndex];
   }
-  return drumNotes[0]; // Fallback to kick drum
+  return activePreset->drumNotes[0]; // Fallback to kick drum
 }
 
-void stopAllPlayingNotes() {
-  int maxButtons = (currentMode == MODE_DRUMS) ? 10 : 7;
-  
-  for (int i = 0; i < maxButtons; i++) {
-    if (noteIsPlaying[i]) {
-      int channel = (currentMode == MODE_DRUMS) ? drumChannel : midiChannel;
-      sendMidiNoteOff(channel, playedMidiNotes[i], 0);
-      noteIsPlaying[i] = false;
-    }
+// Keyboard keys (expander backends) are chromatic: moved by whole octaves
+// in Standard and Arp, by the transpose in Scales, and laid over the GM
+// drum map in Drums. Returns noNote past MIDI 127.
+int calculateKeyboardMidiNote(int key) {
+  int note;
+  if (currentMode == MODE_DRUMS) {
+    note = drumKeyboardBaseNote + key;
+  } else if (currentMode == MODE_SCALES) {
+    note = keyboardBaseNote + semitoneOffset + key;
+  } else {
+    note = keyboardBaseNote + 12 * octaveOffset + key;
   }
+  return note >= 0 && note <= 127 ? note : noNote;
 }
 
 #endif // MIDI_FUNCTIONS_H
\ No newline at end of file
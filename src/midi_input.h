@@ -0,0 +1,32 @@
+/*
+ * midi_input.h - Incoming USB MIDI
+ * 
+ * This file reads packets the host sends to the controller and routes
+ * them: SysEx goes to the configuration transport (sysex_config.h),
+ * clock and transport messages to the arpeggiator (arpeggiator.h).
+ * A bounded number of packets is handled per loop() pass.
+ */
+
+#ifndef MIDI_INPUT_H
+#define MIDI_INPUT_H
+
+// Function declarations
+void pollMidiInput();
+
+void pollMidiInput() {
+  for (uint8_t i = 0; i < midiInputPacketsPerPass; i++) {
+    midiEventPacket_t packet = MidiUSB.read();
+    if (packet.header == 0) {
+      return;   // Nothing more from the host
+    }
+
+    uint8_t cin = packet.header & 0x0F;
+    if (cin >= 0x4 && cin <= 0x7) {
+      receiveSysexPacket(packet);
+    } else if (cin == 0xF) {
+      receiveMidiRealtime(packet.byte1);  // Single-byte: clock, start, continue, stop
+    }
+  }
+}
+
+#endif // MIDI_INPUT_H
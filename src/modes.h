@@ -13,12 +13,15 @@ enum ControllerMode {
   MODE_STANDARD = 0,
   MODE_SCALES = 1,
   MODE_DRUMS = 2,
-  MODE_COUNT = 3
+  MODE_ARP = 3,
+  MODE_CHORDS = 4,
+  MODE_COUNT = 5
 };
 
-extern String modeNames[3];
+extern const char modeNames[5][9];
 
-// Scale types for scales mode
+// Scales with a fixed number, so presets keep them; the full library is
+// in scales.h
 enum ScaleType {
   SCALE_MAJOR = 0,
   SCALE_MINOR = 1,
@@ -30,46 +33,35 @@ enum ScaleType {
   SCALE_MIXOLYDIAN = 7,
   SCALE_LOCRIAN = 8,
   SCALE_PENTATONIC_MAJOR = 9,
-  SCALE_PENTATONIC_MINOR = 10,
-  SCALE_COUNT = 11
+  SCALE_PENTATONIC_MINOR = 10
 };
 
-extern String scaleNames[11];
+// Arpeggiator patterns for arp mode
+enum ArpPattern {
+  ARP_UP = 0,
+  ARP_DOWN = 1,
+  ARP_UP_DOWN = 2,
+  ARP_RANDOM = 3,
+  ARP_AS_PLAYED = 4,
+  ARP_PATTERN_COUNT = 5
+};
 
-// Scale intervals (semitones from root)
-extern const int scaleIntervals[11][7];
+extern const char arpPatternNames[5][8];
 
 // Drums mode - MIDI notes for all 10 buttons
-extern const int drumNotes[10];
-extern const String drumNames[10];
-
-// Initialize mode names
-String modeNames[] = {"Standard", "Scales", "Drums"};
+extern const uint8_t drumNotes[10];
+extern const char drumNames[10][6];
 
-// Initialize scale names
-String scaleNames[] = {
-  "Major", "Minor", "Harmonic", "Melodic", "Dorian", 
-  "Phrygian", "Lydian", "Mixolydian", "Locrian",
-  "Pent.Maj", "Pent.Min"
-};
+// Initialize mode names (name tables live in flash, print them with FPSTR)
+const char modeNames[5][9] PROGMEM = {"Standard", "Scales", "Drums", "Arp", "Chords"};
 
-// Scale intervals (semitones from root)
-const int scaleIntervals[11][7] = {
-  {0, 2, 4, 5, 7, 9, 11},    // Major
-  {0, 2, 3, 5, 7, 8, 10},    // Minor (Natural)
-  {0, 2, 3, 5, 7, 8, 11},    // Harmonic Minor
-  {0, 2, 3, 5, 7, 9, 11},    // Melodic Minor (ascending)
-  {0, 2, 3, 5, 7, 9, 10},    // Dorian
-  {0, 1, 3, 5, 7, 8, 10},    // Phrygian
-  {0, 2, 4, 6, 7, 9, 11},    // Lydian
-  {0, 2, 4, 5, 7, 9, 10},    // Mixolydian
-  {0, 1, 3, 5, 6, 8, 10},    // Locrian
-  {0, 2, 4, 7, 9, 12, 14},   // Pentatonic Major (extended)
-  {0, 3, 5, 7, 10, 12, 15}   // Pentatonic Minor (extended)
+// Initialize arpeggiator pattern names
+const char arpPatternNames[5][8] PROGMEM = {
+  "Up", "Down", "Up-Down", "Random", "Played"
 };
 
 // Drums mode - MIDI notes for all 10 buttons
-const int drumNotes[10] = {
+constexpr uint8_t drumNotes[10] = {
   36, // Kick Drum
   38, // Snare Drum
   42, // Hi-hat Closed
@@ -82,7 +74,7 @@ const int drumNotes[10] = {
   44  // Hi-hat Pedal
 };
 
-const String drumNames[10] = {
+const char drumNames[10][6] PROGMEM = {
   "Kick", "Snare", "HHat", "Open", "Crash", 
   "Ride", "Bell", "Kick2", "Snr2", "Pedal"
 };
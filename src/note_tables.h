@@ -0,0 +1,45 @@
+/*
+ * note_tables.h - Precomputed Note Tables
+ * 
+ * This file expands the note data from config.h and modes.h at compile time
+ * into flash lookup tables, so resolving a button press to a MIDI note is a
+ * single pgm_read_byte(). The static_asserts reject any octave range that
+ * could produce a note outside 0-127. Scales mode resolves its notes from
+ * the scale masks in scales.h instead.
+ */
+
+#ifndef NOTE_TABLES_H
+#define NOTE_TABLES_H
+
+const int numOctaveSteps = maxOctaveOffset - minOctaveOffset + 1;
+
+// === STANDARD MODE ===
+// [octave step][sharp held][button]
+constexpr int standardNote(int button, int octaveStep, int sharp) {
+  return baseNotes[button] + (octaveStep + minOctaveOffset) * 12 + sharp;
+}
+
+#define STANDARD_ROW(o, s) { \
+  standardNote(0, o, s), standardNote(1, o, s), standardNote(2, o, s), standardNote(3, o, s), \
+  standardNote(4, o, s), standardNote(5, o, s), standardNote(6, o, s) }
+#define STANDARD_OCTAVE(o) { STANDARD_ROW(o, 0), STANDARD_ROW(o, 1) }
+
+static_assert(numOctaveSteps == 7, "standardNoteTable below lists exactly 7 octave steps");
+static_assert(standardNote(0, 0, 0) >= 0, "minOctaveOffset takes the lowest note below MIDI 0");
+static_assert(standardNote(6, numOctaveSteps - 1, 1) <= 127, "maxOctaveOffset takes the highest note above MIDI 127");
+
+const uint8_t standardNoteTable[numOctaveSteps][2][7] PROGMEM = {
+  STANDARD_OCTAVE(0), STANDARD_OCTAVE(1), STANDARD_OCTAVE(2), STANDARD_OCTAVE(3),
+  STANDARD_OCTAVE(4), STANDARD_OCTAVE(5), STANDARD_OCTAVE(6)
+};
+
+#undef STANDARD_OCTAVE
+#undef STANDARD_ROW
+
+// === DRUMS MODE ===
+const uint8_t drumNoteTable[10] PROGMEM = {
+  drumNotes[0], drumNotes[1], drumNotes[2], drumNotes[3], drumNotes[4],
+  drumNotes[5], drumNotes[6], drumNotes[7], drumNotes[8], drumNotes[9]
+};
+
+#endif // NOTE_TABLES_H
@@ -0,0 +1,63 @@
+/*
+ * power.h - Idle Sleep
+ * 
+ * This file sleeps the MCU between loop() passes instead of spinning. Idle
+ * sleep stops only the CPU clock, so any interrupt wakes it: the Timer1
+ * scan tick, a port B button's pin change (scanner.h), USB and Timer0's
+ * millis() tick. Every wake sends due arpeggiator steps, loop events and
+ * strummed notes and polls the expanders as the spin did. It also reads
+ * USB MIDI, so clock, transport and SysEx are handled as they arrive and
+ * SysEx replies go out at once. A queued button event or pending serial
+ * input ends the idle at once, so a press or a command is handled without
+ * waiting out the millisecond.
+ * 
+ * The "sleep" STATS stage times each sleep and "STATS power" gives the
+ * share of time asleep; press-to-MIDI stays the "latency" stage.
+ */
+
+#ifndef POWER_H
+#define POWER_H
+
+#include <avr/sleep.h>
+
+// Function declarations
+void idleUntilWork(unsigned long period);
+void sleepUntilInterrupt();
+
+// === IDLE (LOOP CONTEXT) ===
+void idleUntilWork(unsigned long period) {
+  unsigned long idleStart = micros();
+  while (micros() - idleStart < period) {
+    serviceArpeggiator();
+    serviceLooper();
+    serviceChords();
+    serviceInputExpanders();
+    pollMidiInput();
+    flushMidiQueue();
+    if (buttonEventPending() || Serial.available() > 0) {
+      return;
+    }
+    sleepUntilInterrupt();
+  }
+}
+
+// An event queued after the check can't be slept through: the instruction
+// after sei always runs first, so its interrupt wakes sleep_cpu() at once
+void sleepUntilInterrupt() {
+  unsigned long start = micros();
+
+  noInterrupts();
+  if (buttonEventPending()) {
+    interrupts();
+    return;
+  }
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  sleep_enable();
+  interrupts();
+  sleep_cpu();
+  sleep_disable();
+
+  recordSleep(start, micros());
+}
+
+#endif // POWER_H
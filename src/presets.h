@@ -0,0 +1,323 @@
+/*
+ * presets.h - EEPROM Preset Banks
+ * 
+ * This file stores complete controller setups (mode, scale, transpose,
+ * drum map, chords and user scales) as presets in the ATmega32U4's 1 KB EEPROM.
+ * 
+ * EEPROM layout:
+ *   0    Header ring: presetHeaderSlots PresetHeaders (format version and
+ *        the bank that was active last)
+ *   32   Bank 0: presetSlotsPerBank PresetSlots
+ *   ...  Bank 1..presetBankCount-1
+ * 
+ * Every save of a bank goes to the next slot in that bank's ring with a
+ * higher sequence number, so writes are spread over all of its slots. On
+ * load the valid slot (CRC-8 checked) with the highest sequence wins, which
+ * also means an interrupted write just falls back to the previous save.
+ * The active bank is recorded the same way: each bank switch writes the
+ * next record of the header ring, so no single cell takes every switch.
+ * The header CRC is seeded with the magic bytes, which keeps the records
+ * down to four bytes.
+ * 
+ * All banks are cached in RAM. Boot only reads the header and the active
+ * bank; the rest are loaded in the background. Switching presets swaps the
+ * activePreset pointer, and saves are written one byte per loop() pass
+ * whenever the EEPROM is idle, so they never block the scan loop.
+ */
+
+#ifndef PRESETS_H
+#define PRESETS_H
+
+#include <avr/eeprom.h>
+#include <stddef.h>
+#include <util/crc16.h>
+
+const uint8_t presetFormatVersion = 3;
+const uint8_t presetMagic0 = 'M';
+const uint8_t presetMagic1 = 'C';
+
+// Everything a preset recalls
+struct __attribute__((packed)) Preset {
+  uint8_t mode;
+  uint8_t scale;
+  int8_t octaveOffset;
+  int8_t semitoneOffset;
+  uint8_t drumNotes[10];
+  uint16_t chordMasks[numChords];
+  uint8_t chordOctaves[numChords];
+  uint16_t userScales[userScaleCount];   // Pitch class masks, 0 = empty slot
+};
+
+// The SysEx protocol and midi-config.html address these fields by offset;
+// moving any of them means bumping sysexProtocolVersion (sysex_config.h)
+static_assert(offsetof(Preset, drumNotes) == 4, "Preset layout changed");
+static_assert(offsetof(Preset, chordMasks) == 14, "Preset layout changed");
+static_assert(offsetof(Preset, chordOctaves) == 28, "Preset layout changed");
+static_assert(offsetof(Preset, userScales) == 35, "Preset layout changed");
+static_assert(sizeof(Preset) == 43, "Preset layout changed");
+
+struct __attribute__((packed)) PresetSlot {
+  uint16_t sequence;   // Higher = newer
+  Preset preset;
+  uint8_t crc;         // CRC-8 over sequence and preset
+};
+
+struct __attribute__((packed)) PresetHeader {
+  uint8_t version;
+  uint8_t sequence;    // Higher = newer, modulo 256
+  uint8_t activeBank;
+  uint8_t crc;         // CRC-8 over the magic and the bytes above
+};
+
+const uint16_t presetHeaderAddress = 0;
+const uint16_t presetSlotsAddress = presetHeaderAddress + presetHeaderSlots * sizeof(PresetHeader);
+const uint16_t presetStorageEnd = presetSlotsAddress + presetBankCount * presetSlotsPerBank * sizeof(PresetSlot);
+
+static_assert(presetHeaderSlots <= 128, "Header sequence numbers must outrun the ring");
+static_assert(presetStorageEnd <= presetEepromSize, "Preset banks do not fit in their EEPROM area");
+
+// Function declarations
+void loadPresetStorage();
+void loadPresetBank(uint8_t bank);
+void defaultPreset(Preset& preset);
+void applyPreset();
+void capturePreset();
+void selectPreset(uint8_t bank);
+void savePreset();
+void servicePresetStorage();
+uint8_t presetCrc(const uint8_t* data, uint8_t length);
+uint16_t userScaleMask(uint8_t slot);
+uint8_t presetHeaderCrc(const PresetHeader& header);
+
+// External variables needed for presets
+extern ControllerMode currentMode;
+extern uint8_t currentScale;
+extern int octaveOffset;
+extern int semitoneOffset;
+
+Preset presetBanks[presetBankCount];
+Preset* activePreset = &presetBanks[0];
+uint8_t activeBank = 0;
+
+uint8_t presetBanksLoaded = 0;                  // Bit n = bank n read from EEPROM
+uint16_t presetSequence[presetBankCount];       // Sequence of each bank's newest slot
+uint8_t presetNewestSlot[presetBankCount];
+uint8_t storedActiveBank = 0xFF;                // activeBank as recorded in the header
+uint8_t presetHeaderSequence = 0;               // Sequence of the newest header record
+uint8_t presetHeaderSlot = presetHeaderSlots - 1;
+bool presetStorageValid = false;                // False = blank or foreign EEPROM
+
+// Pending writes: banks to save, and whether the header changed
+uint8_t presetSaveRequests = 0;
+bool presetHeaderDirty = false;
+
+// Write in progress: a serialized slot or header going out byte by byte
+uint8_t presetWriteBuffer[sizeof(PresetSlot)];
+uint16_t presetWriteAddress = 0;
+uint8_t presetWriteLength = 0;
+uint8_t presetWriteIndex = 0;
+
+uint8_t presetCrc(const uint8_t* data, uint8_t length) {
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < length; i++) {
+    crc = _crc8_ccitt_update(crc, data[i]);
+  }
+  return crc;
+}
+
+uint8_t presetHeaderCrc(const PresetHeader& header) {
+  uint8_t crc = _crc8_ccitt_update(_crc8_ccitt_update(0, presetMagic0), presetMagic1);
+  const uint8_t* data = (const uint8_t*)&header;
+  for (uint8_t i = 0; i < sizeof(header) - 1; i++) {
+    crc = _crc8_ccitt_update(crc, data[i]);
+  }
+  return crc;
+}
+
+uint16_t presetSlotAddress(uint8_t bank, uint8_t slot) {
+  return presetSlotsAddress + (bank * presetSlotsPerBank + slot) * sizeof(PresetSlot);
+}
+
+// Factory settings: Standard mode, C major, default drum kit and chords,
+// no user scales
+void defaultPreset(Preset& preset) {
+  preset.mode = MODE_STANDARD;
+  preset.scale = SCALE_MAJOR;
+  preset.octaveOffset = 0;
+  preset.semitoneOffset = 0;
+  memcpy_P(preset.drumNotes, drumNoteTable, sizeof(preset.drumNotes));
+  memcpy_P(preset.chordMasks, defaultChordMasks, sizeof(preset.chordMasks));
+  memset(preset.chordOctaves, defaultChordOctave, sizeof(preset.chordOctaves));
+  memset(preset.userScales, 0, sizeof(preset.userScales));
+}
+
+uint16_t userScaleMask(uint8_t slot) {
+  return activePreset->userScales[slot];
+}
+
+// === LOADING ===
+void loadPresetStorage() {
+  PresetHeader header;
+
+  for (uint8_t i = 0; i < presetHeaderSlots; i++) {
+    eeprom_read_block(&header, (const void*)(uintptr_t)(presetHeaderAddress + i * sizeof(header)), sizeof(header));
+
+    bool valid = header.version == presetFormatVersion &&
+                 header.crc == presetHeaderCrc(header) &&
+                 header.activeBank < presetBankCount;
+    if (valid && (!presetStorageValid || (int8_t)(header.sequence - presetHeaderSequence) > 0)) {
+      presetStorageValid = true;
+      presetHeaderSequence = header.sequence;
+      presetHeaderSlot = i;
+      activeBank = header.activeBank;
+    }
+  }
+
+  if (presetStorageValid) {
+    storedActiveBank = activeBank;
+  } else {
+    // Blank or foreign EEPROM: every bank falls back to factory settings
+    // without trusting whatever the slots hold
+    activeBank = 0;
+    presetHeaderDirty = true;
+  }
+
+  loadPresetBank(activeBank);
+  activePreset = &presetBanks[activeBank];
+  applyPreset();
+}
+
+void loadPresetBank(uint8_t bank) {
+  bool found = false;
+  PresetSlot slot;
+
+  if (presetBanksLoaded & (1 << bank)) {
+    return;
+  }
+
+  for (uint8_t i = 0; presetStorageValid && i < presetSlotsPerBank; i++) {
+    eeprom_read_block(&slot, (const void*)(uintptr_t)presetSlotAddress(bank, i), sizeof(slot));
+
+    if (slot.crc != presetCrc((const uint8_t*)&slot, sizeof(slot) - 1)) {
+      continue;
+    }
+    // Sequence numbers compare modulo 2^16, so wrapping after 65535 saves is fine
+    if (!found || (int16_t)(slot.sequence - presetSequence[bank]) > 0) {
+      found = true;
+      presetSequence[bank] = slot.sequence;
+      presetNewestSlot[bank] = i;
+      presetBanks[bank] = slot.preset;
+    }
+  }
+
+  if (!found) {
+    defaultPreset(presetBanks[bank]);
+    presetSequence[bank] = 0;
+    presetNewestSlot[bank] = presetSlotsPerBank - 1; // First save goes to slot 0
+  }
+
+  presetBanksLoaded |= (1 << bank);
+}
+
+// === SWITCHING ===
+// Live settings follow the active preset; the drum map and chords are read
+// straight from activePreset
+void applyPreset() {
+  const Preset& preset = *activePreset;
+
+  currentMode = preset.mode < MODE_COUNT ? (ControllerMode)preset.mode : MODE_STANDARD;
+  currentScale = scaleAvailable(preset.scale) ? preset.scale : (uint8_t)SCALE_MAJOR;
+  expandedScale = 0xFF;   // A user scale of the same number may differ
+  octaveOffset = constrain(preset.octaveOffset, minOctaveOffset, maxOctaveOffset);
+  semitoneOffset = constrain(preset.semitoneOffset, minSemitoneOffset, maxSemitoneOffset);
+}
+
+void capturePreset() {
+  activePreset->mode = currentMode;
+  activePreset->scale = currentScale;
+  activePreset->octaveOffset = octaveOffset;
+  activePreset->semitoneOffset = semitoneOffset;
+}
+
+// Constant time once the bank is cached (which it is shortly after boot)
+void selectPreset(uint8_t bank) {
+  if (bank >= presetBankCount) {
+    return;
+  }
+
+  capturePreset();
+  loadPresetBank(bank);
+  activeBank = bank;
+  activePreset = &presetBanks[bank];
+  applyPreset();
+
+  presetHeaderDirty = activeBank != storedActiveBank;
+}
+
+// Queues the active preset for writing; returns immediately
+void savePreset() {
+  capturePreset();
+  presetSaveRequests |= (1 << activeBank);
+}
+
+// === DEFERRED EEPROM WRITES ===
+// One step per loop() pass: never starts an EEPROM access while the
+// previous byte is still being programmed, so it never waits.
+void servicePresetStorage() {
+  if (!eeprom_is_ready()) {
+    return;
+  }
+
+  if (presetWriteIndex < presetWriteLength) {
+    eeprom_update_byte((uint8_t*)(uintptr_t)(presetWriteAddress + presetWriteIndex), presetWriteBuffer[presetWriteIndex]);
+    presetWriteIndex++;
+    return;
+  }
+
+  if (presetSaveRequests != 0) {
+    uint8_t bank = 0;
+    while (!(presetSaveRequests & (1 << bank))) {
+      bank++;
+    }
+    presetSaveRequests &= ~(1 << bank);
+
+    // Snapshot the preset now so later edits can't tear the record
+    PresetSlot& slot = *(PresetSlot*)presetWriteBuffer;
+    slot.sequence = presetSequence[bank] + 1;
+    slot.preset = presetBanks[bank];
+    slot.crc = presetCrc(presetWriteBuffer, sizeof(PresetSlot) - 1);
+
+    uint8_t next = (presetNewestSlot[bank] + 1) % presetSlotsPerBank;
+    presetSequence[bank] = slot.sequence;
+    presetNewestSlot[bank] = next;
+
+    presetWriteAddress = presetSlotAddress(bank, next);
+    presetWriteLength = sizeof(PresetSlot);
+    presetWriteIndex = 0;
+  } else if (presetHeaderDirty) {
+    presetHeaderDirty = false;
+
+    PresetHeader& header = *(PresetHeader*)presetWriteBuffer;
+    header.version = presetFormatVersion;
+    header.sequence = presetHeaderSequence + 1;
+    header.activeBank = activeBank;
+    header.crc = presetHeaderCrc(header);
+    storedActiveBank = activeBank;
+
+    presetHeaderSlot = (presetHeaderSlot + 1) % presetHeaderSlots;
+    presetHeaderSequence = header.sequence;
+
+    presetWriteAddress = presetHeaderAddress + presetHeaderSlot * sizeof(PresetHeader);
+    presetWriteLength = sizeof(PresetHeader);
+    presetWriteIndex = 0;
+  } else if (presetBanksLoaded != (1 << presetBankCount) - 1) {
+    // Idle: cache the next bank that hasn't been read yet
+    uint8_t bank = 0;
+    while (presetBanksLoaded & (1 << bank)) {
+      bank++;
+    }
+    loadPresetBank(bank);
+  }
+}
+
+#endif // PRESETS_H
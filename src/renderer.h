@@ -0,0 +1,232 @@
+/*
+ * renderer.h - Page-Mode Display List Renderer
+ * 
+ * Screens are described as a short display list of text and bitmap items
+ * instead of being drawn into a 512-byte frame buffer. The SSD1306 stores
+ * pixels as pages of 8 rows by 128 columns, one byte per column, so a frame
+ * can be produced in the order it is sent: renderDisplayChunk() builds the
+ * next few columns of a page by ORing together every item covering them,
+ * and serviceDisplayFlush() (display.h) streams them straight to the panel.
+ * Only the display list and one chunk are ever held in SRAM.
+ * 
+ * Fixed text comes pre-rendered from glyph_cache.h and is copied out a
+ * whole byte per column; the font path is left for numbers and the splash.
+ * Font text is copied into a small pool when drawn, so callers may reuse
+ * their buffers; flash strings and bitmaps are referenced in place. Items
+ * that don't fit in the list or pool are dropped.
+ */
+
+#ifndef RENDERER_H
+#define RENDERER_H
+
+enum DisplayItemKind {
+  ITEM_TEXT = 0,       // Characters in displayTextPool
+  ITEM_TEXT_P = 1,     // PROGMEM string
+  ITEM_BITMAP_P = 2,   // PROGMEM bitmap, rows MSB first (drawBitmap layout)
+  ITEM_GLYPHS_P = 3,   // glyph_cache.h strip, already in page layout
+  ITEM_ANIMATION = 4   // Drawn column by column by renderAnimationColumn()
+};
+
+struct DisplayItem {
+  uint8_t kind;
+  uint8_t x;
+  uint8_t y;
+  uint8_t width;       // Pixels covered, clipped to the screen
+  uint8_t height;
+  uint8_t scale;       // Text size, bytes per bitmap row, strip width or animation
+  const char* data;
+};
+
+// Function declarations
+void clearDisplayList();
+void drawText(uint8_t x, uint8_t y, const char* text, uint8_t size);
+void drawTextP(uint8_t x, uint8_t y, const char* text, uint8_t size);
+void drawNumber(uint8_t x, uint8_t y, int value, uint8_t size, bool showPlus);
+void drawBitmapP(uint8_t x, uint8_t y, const uint8_t* bitmap, uint8_t width, uint8_t height);
+uint8_t drawGlyphs(uint8_t x, uint8_t y, uint8_t glyph);
+bool addDisplayItem(uint8_t kind, uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t scale, const char* data);
+void renderDisplayChunk(uint8_t page, uint8_t column, uint8_t* out, uint8_t count);
+uint8_t renderTextColumn(const DisplayItem& item, uint8_t dx, uint8_t top);
+uint8_t renderBitmapColumn(const DisplayItem& item, uint8_t dx, uint8_t top);
+uint8_t renderGlyphColumn(const DisplayItem& item, uint8_t dx, uint8_t top);
+uint8_t pageRows(uint8_t firstRow, uint8_t lastRow, uint8_t top);
+// Note: renderAnimationColumn() is defined in display.h
+uint8_t renderAnimationColumn(const DisplayItem& item, uint8_t dx, uint8_t top);
+
+DisplayItem displayList[displayListSize];
+uint8_t displayListLength = 0;
+char displayTextPool[displayTextPoolSize];
+uint8_t displayTextPoolUsed = 0;
+
+// === BUILDING THE DISPLAY LIST ===
+void clearDisplayList() {
+  displayListLength = 0;
+  displayTextPoolUsed = 0;
+}
+
+bool addDisplayItem(uint8_t kind, uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t scale, const char* data) {
+  if (displayListLength == displayListSize || x >= SCREEN_WIDTH || y >= SCREEN_HEIGHT) {
+    return false;
+  }
+
+  DisplayItem& item = displayList[displayListLength++];
+  item.kind = kind;
+  item.x = x;
+  item.y = y;
+  item.width = width < SCREEN_WIDTH - x ? width : SCREEN_WIDTH - x;
+  item.height = height < SCREEN_HEIGHT - y ? height : SCREEN_HEIGHT - y;
+  item.scale = scale;
+  item.data = data;
+  return true;
+}
+
+// Sizes 1 (6x8 cells) and 2 (12x16 cells)
+void drawText(uint8_t x, uint8_t y, const char* text, uint8_t size) {
+  uint8_t length = strlen(text);
+  if (length == 0 || displayTextPoolUsed + length > displayTextPoolSize) {
+    return;
+  }
+
+  size = size > 1 ? 2 : 1;
+  char* copy = displayTextPool + displayTextPoolUsed;
+  if (addDisplayItem(ITEM_TEXT, x, y, min(length * 6 * size, 255), 8 * size, size, copy)) {
+    memcpy(copy, text, length);
+    displayTextPoolUsed += length;
+  }
+}
+
+void drawTextP(uint8_t x, uint8_t y, const char* text, uint8_t size) {
+  uint8_t length = strlen_P(text);
+  size = size > 1 ? 2 : 1;
+  addDisplayItem(ITEM_TEXT_P, x, y, min(length * 6 * size, 255), 8 * size, size, text);
+}
+
+void drawNumber(uint8_t x, uint8_t y, int value, uint8_t size, bool showPlus) {
+  char text[8];
+  char* end = text + sizeof(text) - 1;
+  *end = '\0';
+
+  unsigned int magnitude = value < 0 ? -value : value;
+  do {
+    *--end = '0' + magnitude % 10;
+    magnitude /= 10;
+  } while (magnitude > 0);
+
+  if (value < 0) {
+    *--end = '-';
+  } else if (showPlus) {
+    *--end = '+';
+  }
+  drawText(x, y, end, size);
+}
+
+void drawBitmapP(uint8_t x, uint8_t y, const uint8_t* bitmap, uint8_t width, uint8_t height) {
+  addDisplayItem(ITEM_BITMAP_P, x, y, width, height, (width + 7) / 8, (const char*)bitmap);
+}
+
+// Returns the strip's width, to place whatever follows it
+uint8_t drawGlyphs(uint8_t x, uint8_t y, uint8_t glyph) {
+  GlyphStrip strip;
+  memcpy_P(&strip, &glyphStrips[glyph], sizeof(strip));
+  addDisplayItem(ITEM_GLYPHS_P, x, y, strip.width, strip.bands * 8, strip.width,
+                 (const char*)glyphBitmaps + strip.offset);
+  return strip.width;
+}
+
+// === RASTERIZING ===
+// Fills out[] with columns column..column+count-1 of one page
+void renderDisplayChunk(uint8_t page, uint8_t column, uint8_t* out, uint8_t count) {
+  memset(out, 0, count);
+  uint8_t top = page * 8;
+
+  for (uint8_t i = 0; i < displayListLength; i++) {
+    const DisplayItem& item = displayList[i];
+    if (item.y >= top + 8 || item.y + item.height <= top) {
+      continue;
+    }
+
+    // Columns this item shares with the chunk
+    int from = max((int)column, (int)item.x);
+    int to = min(column + count, item.x + item.width);
+    for (int x = from; x < to; x++) {
+      if (item.kind == ITEM_GLYPHS_P) {
+        out[x - column] |= renderGlyphColumn(item, x - item.x, top);
+      } else if (item.kind == ITEM_ANIMATION) {
+        out[x - column] |= renderAnimationColumn(item, x - item.x, top);
+      } else if (item.kind == ITEM_BITMAP_P) {
+        out[x - column] |= renderBitmapColumn(item, x - item.x, top);
+      } else {
+        out[x - column] |= renderTextColumn(item, x - item.x, top);
+      }
+    }
+  }
+}
+
+// One page byte of a text item, dx pixels from its left edge
+uint8_t renderTextColumn(const DisplayItem& item, uint8_t dx, uint8_t top) {
+  uint8_t cell = 6 * item.scale;
+  uint8_t glyphColumn = (dx % cell) / item.scale;
+  if (glyphColumn >= fontGlyphWidth) {
+    return 0;   // Gap between characters
+  }
+
+  const char* position = item.data + dx / cell;
+  char c = item.kind == ITEM_TEXT_P ? pgm_read_byte(position) : *position;
+  if (c < fontFirstChar || c > fontLastChar) {
+    c = '?';
+  }
+  uint8_t glyph = pgm_read_byte(&font5x7[c - fontFirstChar][glyphColumn]);
+
+  // Column pixels top-down, every row doubled at size 2
+  uint16_t pixels = glyph;
+  if (item.scale == 2) {
+    pixels = 0;
+    for (uint8_t row = 0; row < 7; row++) {
+      if (glyph & (1 << row)) {
+        pixels |= 3 << (row * 2);
+      }
+    }
+  }
+
+  // Shift the item's rows into this page's 8
+  int8_t shift = item.y - top;
+  return shift >= 0 ? (uint8_t)(pixels << shift) : (uint8_t)(pixels >> -shift);
+}
+
+uint8_t renderBitmapColumn(const DisplayItem& item, uint8_t dx, uint8_t top) {
+  const uint8_t* bitmap = (const uint8_t*)item.data + dx / 8;
+  uint8_t mask = 0x80 >> (dx & 7);
+  uint8_t bits = 0;
+
+  for (uint8_t bit = 0; bit < 8; bit++) {
+    int row = top + bit - item.y;
+    if (row >= 0 && row < item.height && (pgm_read_byte(bitmap + row * item.scale) & mask)) {
+      bits |= 1 << bit;
+    }
+  }
+  return bits;
+}
+
+// One or two whole bytes: the strip's bands that overlap this page
+uint8_t renderGlyphColumn(const DisplayItem& item, uint8_t dx, uint8_t top) {
+  const uint8_t* column = (const uint8_t*)item.data + dx;
+  uint16_t pixels = pgm_read_byte(column);
+  if (item.height > 8) {
+    pixels |= pgm_read_byte(column + item.scale) << 8;
+  }
+
+  int8_t shift = item.y - top;
+  return shift >= 0 ? (uint8_t)(pixels << shift) : (uint8_t)(pixels >> -shift);
+}
+
+// Page byte with screen rows firstRow..lastRow set, for procedural items
+uint8_t pageRows(uint8_t firstRow, uint8_t lastRow, uint8_t top) {
+  if (lastRow < top || firstRow > top + 7) {
+    return 0;
+  }
+  uint8_t from = firstRow > top ? firstRow - top : 0;
+  uint8_t to = lastRow < top + 7 ? lastRow - top : 7;
+  return (uint8_t)(0xFF << from) & (0xFF >> (7 - to));
+}
+
+#endif // RENDERER_H
@@ -0,0 +1,130 @@
+/*
+ * routing.h - Split/Layer Output Routing
+ * 
+ * Melodic notes (Standard, Scales, Arp and the keyboard keys) go out
+ * through up to routeLayerCount layers instead of one fixed channel. A
+ * layer covers a range of logical buttons and sends their notes to its own
+ * channel with its own transpose: overlapping layers stack sounds (a bass
+ * an octave down on channel 2), adjacent ones split the buttons between
+ * instruments. Drums stay on drumChannel.
+ * 
+ * The layers covering each button are folded into a bitmask whenever the
+ * layers change, so a press visits at most routeLayerCount layers; the
+ * "route" STATS stage times the whole fan-out. Each layer has its own
+ * active_notes.h slot, and a press reserves room in the USB transfer being
+ * filled so all of its packets leave together. Layers live in RAM and are
+ * set with SET_LAYER (serial_commands.h); by default layer 0 sends every
+ * button on midiChannel and the others are off.
+ */
+
+#ifndef ROUTING_H
+#define ROUTING_H
+
+struct RouteLayer {
+  uint8_t channel;       // 0-15, noChannel when the layer is off
+  int8_t transpose;      // Semitones added to every note
+  uint8_t firstButton;   // Logical buttons covered, inclusive
+  uint8_t lastButton;
+};
+
+// Function declarations
+void resetRouting();
+void setRouteLayer(uint8_t layer, const RouteLayer& settings);
+void rebuildRouting();
+void playRoutedNote(uint8_t button, uint8_t note, uint8_t velocity);
+void releaseRoutedNote(uint8_t button, uint8_t note);
+uint8_t routeFanoutCount(uint8_t button);
+
+RouteLayer routeLayers[routeLayerCount];
+
+// Bit n set = layer n plays this button
+uint8_t routeFanout[numButtons];
+
+static_assert(routeLayerCount <= 8, "routeFanout holds a bit per layer");
+
+void resetRouting() {
+  for (uint8_t layer = 0; layer < routeLayerCount; layer++) {
+    routeLayers[layer].channel = layer == 0 ? midiChannel : noChannel;
+    routeLayers[layer].transpose = 0;
+    routeLayers[layer].firstButton = 0;
+    routeLayers[layer].lastButton = numButtons - 1;
+  }
+  rebuildRouting();
+}
+
+// Held notes would be released on the wrong channel afterwards, so
+// everything is silenced before the layer changes
+void setRouteLayer(uint8_t layer, const RouteLayer& settings) {
+  stopAllPlayingNotes();
+  routeLayers[layer] = settings;
+  rebuildRouting();
+}
+
+void rebuildRouting() {
+  for (uint8_t button = 0; button < numButtons; button++) {
+    routeFanout[button] = 0;
+  }
+
+  for (uint8_t layer = 0; layer < routeLayerCount; layer++) {
+    const RouteLayer& settings = routeLayers[layer];
+    activeNoteChannels[layer] = settings.channel;
+    if (settings.channel == noChannel) {
+      continue;
+    }
+    for (uint8_t button = settings.firstButton; button <= settings.lastButton && button < numButtons; button++) {
+      routeFanout[button] |= 1 << layer;
+    }
+  }
+}
+
+// === FAN-OUT ===
+// Packets one note of this button sends, one per layer covering it
+uint8_t routeFanoutCount(uint8_t button) {
+  uint8_t count = 0;
+  for (uint8_t fanout = routeFanout[button]; fanout != 0; fanout >>= 1) {
+    count += fanout & 1;
+  }
+  return count;
+}
+
+// Reserving only this note's own packets lets a caller reserve several
+// notes at once (a chord) without each one flushing the transfer early
+void playRoutedNote(uint8_t button, uint8_t note, uint8_t velocity) {
+  unsigned long start = micros();
+  reserveMidiTransfer(routeFanoutCount(button));
+
+  uint8_t fanout = routeFanout[button];
+  for (uint8_t layer = 0; fanout != 0; layer++, fanout >>= 1) {
+    if (!(fanout & 1)) {
+      continue;
+    }
+    int routed = note + routeLayers[layer].transpose;
+    if (routed >= 0 && routed <= 127) {
+      playNote(routeLayers[layer].channel, routed, velocity);
+    }
+  }
+
+  recordStage(STAGE_ROUTE, micros() - start);
+}
+
+// Layers can't have changed since the press (see setRouteLayer), so the
+// note-offs mirror the note-ons exactly
+void releaseRoutedNote(uint8_t button, uint8_t note) {
+  unsigned long start = micros();
+  reserveMidiTransfer(routeFanoutCount(button));
+
+  uint8_t fanout = routeFanout[button];
+  for (uint8_t layer = 0; fanout != 0; layer++, fanout >>= 1) {
+    if (!(fanout & 1)) {
+      continue;
+    }
+    int routed = note + routeLayers[layer].transpose;
+    if (routed >= 0 && routed <= 127) {
+      releaseNote(routeLayers[layer].channel, routed);
+    }
+  }
+
+  recordStage(STAGE_ROUTE, micros() - start);
+}
+
+#endif // ROUTING_H
@@ -0,0 +1,332 @@
+/*
+ * scales.h - Scale Library
+ * 
+ * Every scale is a 12-bit pitch class mask in flash (bit n = n semitones
+ * above the root), so an entry costs its 2-byte mask plus its name and
+ * nothing in SRAM; scales are added by adding a line to SCALE_LIBRARY. Any
+ * length from 1 to 12 notes works: the 7 note buttons walk up the scale's
+ * degrees and wrap into the next octave when they run out, so a pentatonic
+ * scale's buttons 6 and 7 play its first two degrees an octave up.
+ * 
+ * The library holds 199 scales. After them come userScaleCount user
+ * scales, masks stored in each preset (presets.h) and set with SET_SCALE
+ * (serial_commands.h) or SysEx: user slot n is scale number scaleCount + n.
+ * The sharp button skips user slots that are empty.
+ * 
+ * The root is any MIDI note; Scales mode plays from scaleRootNote moved by
+ * the transpose. The current scale's mask is expanded once per scale change
+ * into an interval per button, so resolving a press stays a single lookup.
+ */
+
+#ifndef SCALES_H
+#define SCALES_H
+
+// Mask from intervals in semitones above the root
+constexpr uint16_t scaleMask() {
+  return 0;
+}
+
+template <typename... Intervals>
+constexpr uint16_t scaleMask(int interval, Intervals... rest) {
+  return (1 << interval) | scaleMask(rest...);
+}
+
+// X(name, intervals...), names at most 10 characters. The first 11 entries
+// keep the ScaleType numbers (modes.h) that presets store.
+#define SCALE_LIBRARY(X) \
+  /* Major and its modes, the original library */ \
+  X("Major",      0, 2, 4, 5, 7, 9, 11) \
+  X("Minor",      0, 2, 3, 5, 7, 8, 10) \
+  X("Harmonic",   0, 2, 3, 5, 7, 8, 11) \
+  X("Melodic",    0, 2, 3, 5, 7, 9, 11) \
+  X("Dorian",     0, 2, 3, 5, 7, 9, 10) \
+  X("Phrygian",   0, 1, 3, 5, 7, 8, 10) \
+  X("Lydian",     0, 2, 4, 6, 7, 9, 11) \
+  X("Mixolydian", 0, 2, 4, 5, 7, 9, 10) \
+  X("Locrian",    0, 1, 3, 5, 6, 8, 10) \
+  X("Pent.Maj",   0, 2, 4, 7, 9) \
+  X("Pent.Min",   0, 3, 5, 7, 10) \
+  /* Modes of melodic minor */ \
+  X("Dorian b2",  0, 1, 3, 5, 7, 9, 10) \
+  X("Lydian #5",  0, 2, 4, 6, 8, 9, 11) \
+  X("Lydian b7",  0, 2, 4, 6, 7, 9, 10) \
+  X("Mixo b6",    0, 2, 4, 5, 7, 8, 10) \
+  X("Locrian #2", 0, 2, 3, 5, 6, 8, 10) \
+  X("Altered",    0, 1, 3, 4, 6, 8, 10) \
+  /* Modes of harmonic minor */ \
+  X("Locrian #6", 0, 1, 3, 5, 6, 9, 10) \
+  X("Ionian #5",  0, 2, 4, 5, 8, 9, 11) \
+  X("Dorian #4",  0, 2, 3, 6, 7, 9, 10) \
+  X("Phryg.Dom",  0, 1, 4, 5, 7, 8, 10) \
+  X("Lydian #2",  0, 3, 4, 6, 7, 9, 11) \
+  X("Ultraloc.",  0, 1, 3, 4, 6, 8, 9) \
+  /* Harmonic major and its modes */ \
+  X("Harm.Maj",   0, 2, 4, 5, 7, 8, 11) \
+  X("Dorian b5",  0, 2, 3, 5, 6, 9, 10) \
+  X("Phryg.b4",   0, 1, 3, 4, 7, 8, 10) \
+  X("Lydian b3",  0, 2, 3, 6, 7, 9, 11) \
+  X("Mixo b2",    0, 1, 4, 5, 7, 9, 10) \
+  X("Lyd.Aug#2",  0, 3, 4, 6, 8, 9, 11) \
+  X("Locr.bb7",   0, 1, 3, 5, 6, 8, 9) \
+  /* Double harmonic and its modes */ \
+  X("Dbl.Harm",   0, 1, 4, 5, 7, 8, 11) \
+  X("Lyd.#2#6",   0, 3, 4, 6, 7, 10, 11) \
+  X("Ultraphryg", 0, 1, 3, 4, 7, 8, 9) \
+  X("Hung.Min",   0, 2, 3, 6, 7, 8, 11) \
+  X("Oriental",   0, 1, 4, 5, 6, 9, 10) \
+  X("Ion.#2#5",   0, 3, 4, 5, 8, 9, 11) \
+  X("Locr.bb3b7", 0, 1, 2, 5, 6, 8, 9) \
+  /* Other heptatonic */ \
+  X("Neap.Maj",   0, 1, 3, 5, 7, 9, 11) \
+  X("Neap.Min",   0, 1, 3, 5, 7, 8, 11) \
+  X("Hung.Maj",   0, 3, 4, 6, 7, 9, 10) \
+  X("Enigmatic",  0, 1, 4, 6, 8, 10, 11) \
+  X("Persian",    0, 1, 4, 5, 6, 8, 11) \
+  X("Maj.Locr.",  0, 2, 4, 5, 6, 8, 10) \
+  X("Lead.Whole", 0, 2, 4, 6, 8, 10, 11) \
+  X("Gypsy",      0, 2, 3, 6, 7, 8, 10) \
+  /* Pentatonic */ \
+  X("Egyptian",   0, 2, 5, 7, 10) \
+  X("Man Gong",   0, 3, 5, 8, 10) \
+  X("Yo",         0, 2, 5, 7, 9) \
+  X("Dom.Pent",   0, 2, 4, 7, 10) \
+  X("Hirajoshi",  0, 2, 3, 7, 8) \
+  X("In Sen",     0, 1, 5, 7, 10) \
+  X("Iwato",      0, 1, 5, 6, 10) \
+  X("Kumoi",      0, 2, 3, 7, 9) \
+  X("Pelog",      0, 1, 3, 7, 8) \
+  X("Chinese",    0, 4, 6, 7, 11) \
+  /* Hexatonic */ \
+  X("Blues",      0, 3, 5, 6, 7, 10) \
+  X("Maj.Blues",  0, 2, 3, 4, 7, 9) \
+  X("Whole Tone", 0, 2, 4, 6, 8, 10) \
+  X("Augmented",  0, 3, 4, 7, 8, 11) \
+  X("Prometheus", 0, 2, 4, 6, 9, 10) \
+  X("Tritone",    0, 1, 4, 6, 7, 10) \
+  X("Maj.Hexa",   0, 2, 4, 5, 7, 9) \
+  X("Min.Hexa",   0, 2, 3, 5, 7, 10) \
+  /* Octatonic */ \
+  X("Dim.W-H",    0, 2, 3, 5, 6, 8, 9, 11) \
+  X("Dim.H-W",    0, 1, 3, 4, 6, 7, 9, 10) \
+  X("Bebop Dom",  0, 2, 4, 5, 7, 9, 10, 11) \
+  X("Bebop Maj",  0, 2, 4, 5, 7, 8, 9, 11) \
+  X("Bebop Min",  0, 2, 3, 4, 5, 7, 9, 10) \
+  X("Bebop Dor",  0, 2, 3, 5, 7, 9, 10, 11) \
+  /* Messiaen's modes of limited transposition (1 and 2 are above) */ \
+  X("Messiaen 3", 0, 2, 3, 4, 6, 7, 8, 10, 11) \
+  X("Messiaen 4", 0, 1, 2, 5, 6, 7, 8, 11) \
+  X("Messiaen 5", 0, 1, 5, 6, 7, 11) \
+  X("Messiaen 6", 0, 2, 4, 5, 6, 8, 10, 11) \
+  X("Messiaen 7", 0, 1, 2, 3, 5, 6, 7, 8, 9, 11) \
+  X("Chromatic",  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11) \
+  /* The melakarta ragas in order, less the 24 that are modes above */ \
+  X("Kanakangi",  0, 1, 2, 5, 7, 8, 9) \
+  X("Ratnangi",   0, 1, 2, 5, 7, 8, 10) \
+  X("Ganamurthi", 0, 1, 2, 5, 7, 8, 11) \
+  X("Vanaspati",  0, 1, 2, 5, 7, 9, 10) \
+  X("Manavati",   0, 1, 2, 5, 7, 9, 11) \
+  X("Tanarupi",   0, 1, 2, 5, 7, 10, 11) \
+  X("Senavati",   0, 1, 3, 5, 7, 8, 9) \
+  X("Rupavati",   0, 1, 3, 5, 7, 10, 11) \
+  X("Gayakapri.", 0, 1, 4, 5, 7, 8, 9) \
+  X("Suryakant.", 0, 1, 4, 5, 7, 9, 11) \
+  X("Hatakamba.", 0, 1, 4, 5, 7, 10, 11) \
+  X("Jhankarad.", 0, 2, 3, 5, 7, 8, 9) \
+  X("Varunapri.", 0, 2, 3, 5, 7, 10, 11) \
+  X("Mararanja.", 0, 2, 4, 5, 7, 8, 9) \
+  X("Naganandi.", 0, 2, 4, 5, 7, 10, 11) \
+  X("Yagapriya",  0, 3, 4, 5, 7, 8, 9) \
+  X("Ragavardh.", 0, 3, 4, 5, 7, 8, 10) \
+  X("Gangeyabh.", 0, 3, 4, 5, 7, 8, 11) \
+  X("Vagadhees.", 0, 3, 4, 5, 7, 9, 10) \
+  X("Shulini",    0, 3, 4, 5, 7, 9, 11) \
+  X("Chalanata",  0, 3, 4, 5, 7, 10, 11) \
+  X("Salagam",    0, 1, 2, 6, 7, 8, 9) \
+  X("Jalarnavam", 0, 1, 2, 6, 7, 8, 10) \
+  X("Jhalavara.", 0, 1, 2, 6, 7, 8, 11) \
+  X("Navaneetam", 0, 1, 2, 6, 7, 9, 10) \
+  X("Pavani",     0, 1, 2, 6, 7, 9, 11) \
+  X("Raghupriya", 0, 1, 2, 6, 7, 10, 11) \
+  X("Gavambhodi", 0, 1, 3, 6, 7, 8, 9) \
+  X("Bhavapriya", 0, 1, 3, 6, 7, 8, 10) \
+  X("Shubhapan.", 0, 1, 3, 6, 7, 8, 11) \
+  X("Shadvidam.", 0, 1, 3, 6, 7, 9, 10) \
+  X("Suvarnangi", 0, 1, 3, 6, 7, 9, 11) \
+  X("Divyamani",  0, 1, 3, 6, 7, 10, 11) \
+  X("Dhavalamb.", 0, 1, 4, 6, 7, 8, 9) \
+  X("Namanaray.", 0, 1, 4, 6, 7, 8, 10) \
+  X("Kamavardh.", 0, 1, 4, 6, 7, 8, 11) \
+  X("Ramapriya",  0, 1, 4, 6, 7, 9, 10) \
+  X("Gamanashr.", 0, 1, 4, 6, 7, 9, 11) \
+  X("Vishwamba.", 0, 1, 4, 6, 7, 10, 11) \
+  X("Shamalangi", 0, 2, 3, 6, 7, 8, 9) \
+  X("Neetimati",  0, 2, 3, 6, 7, 10, 11) \
+  X("Kantamani",  0, 2, 4, 6, 7, 8, 9) \
+  X("Rishabhap.", 0, 2, 4, 6, 7, 8, 10) \
+  X("Latangi",    0, 2, 4, 6, 7, 8, 11) \
+  X("Chitramba.", 0, 2, 4, 6, 7, 10, 11) \
+  X("Sucharitra", 0, 3, 4, 6, 7, 8, 9) \
+  X("Jyotiswar.", 0, 3, 4, 6, 7, 8, 10) \
+  X("Dhatuvard.", 0, 3, 4, 6, 7, 8, 11) \
+  /* Pentatonic and hexatonic ragas */ \
+  X("Abhogi",     0, 2, 3, 5, 9) \
+  X("Hamsadhw.",  0, 2, 4, 7, 11) \
+  X("Sriranjani", 0, 2, 3, 5, 9, 10) \
+  X("Malayamar.", 0, 1, 4, 7, 9, 10) \
+  X("Madhukauns", 0, 3, 6, 7, 10) \
+  X("Chandrak.",  0, 3, 5, 8, 11) \
+  X("Marwa",      0, 1, 4, 6, 9, 11) \
+  X("Jog",        0, 3, 4, 5, 7, 10) \
+  X("Gunakali",   0, 1, 5, 7, 8) \
+  X("Vibhas",     0, 1, 4, 7, 8) \
+  X("Bh.Shadja",  0, 4, 5, 9, 11) \
+  X("Hindol",     0, 4, 6, 9, 11) \
+  X("Valaji",     0, 4, 7, 9, 10) \
+  X("Nagaswar.",  0, 4, 5, 7, 9) \
+  X("Gambhir.",   0, 4, 5, 7, 11) \
+  X("Bahudari",   0, 4, 5, 7, 9, 10) \
+  /* Modes of scales above, by the degree they start on, less those listed */ \
+  X("Neap.Maj 3", 0, 2, 4, 6, 8, 9, 10) \
+  X("Neap.Maj 6", 0, 2, 3, 4, 6, 8, 10) \
+  X("Neap.Maj 7", 0, 1, 2, 4, 6, 8, 10) \
+  X("Neap.Min 3", 0, 2, 4, 5, 8, 9, 10) \
+  X("Neap.Min 5", 0, 1, 4, 5, 6, 8, 10) \
+  X("Neap.Min 7", 0, 1, 2, 4, 6, 8, 9) \
+  X("Hung.Maj 2", 0, 1, 3, 4, 6, 7, 9) \
+  X("Hung.Maj 3", 0, 2, 3, 5, 6, 8, 11) \
+  X("Hung.Maj 4", 0, 1, 3, 4, 6, 9, 10) \
+  X("Hung.Maj 5", 0, 2, 3, 5, 8, 9, 11) \
+  X("Hung.Maj 7", 0, 2, 5, 6, 8, 9, 11) \
+  X("Enigm. 2",   0, 3, 5, 7, 9, 10, 11) \
+  X("Enigm. 4",   0, 2, 4, 5, 6, 7, 10) \
+  X("Enigm. 5",   0, 2, 3, 4, 5, 8, 10) \
+  X("Enigm. 6",   0, 1, 2, 3, 6, 8, 10) \
+  X("Persian 3",  0, 1, 2, 4, 7, 8, 9) \
+  X("Persian 5",  0, 2, 5, 6, 7, 10, 11) \
+  X("Persian 6",  0, 3, 4, 5, 8, 9, 10) \
+  X("Persian 7",  0, 1, 2, 5, 6, 7, 9) \
+  X("In Sen 3",   0, 2, 5, 7, 8) \
+  X("In Sen 4",   0, 3, 5, 6, 10) \
+  X("Pelog 2",    0, 2, 6, 7, 11) \
+  X("Pelog 3",    0, 4, 5, 9, 10) \
+  X("Pelog 4",    0, 1, 5, 6, 8) \
+  X("Blues 3",    0, 1, 2, 5, 7, 10) \
+  X("Blues 5",    0, 3, 5, 8, 10, 11) \
+  X("Blues 6",    0, 2, 5, 7, 8, 9) \
+  X("Prometh. 2", 0, 2, 4, 7, 8, 10) \
+  X("Prometh. 3", 0, 2, 5, 6, 8, 10) \
+  X("Prometh. 4", 0, 3, 4, 6, 8, 10) \
+  X("Prometh. 5", 0, 1, 3, 5, 7, 9) \
+  X("Prometh. 6", 0, 2, 4, 6, 8, 11) \
+  X("Tritone 2",  0, 3, 5, 6, 9, 11) \
+  X("Tritone 3",  0, 2, 3, 6, 8, 9) \
+  X("BebopDom 2", 0, 2, 3, 5, 7, 8, 9, 10) \
+  X("BebopDom 3", 0, 1, 3, 5, 6, 7, 8, 10) \
+  X("BebopDom 4", 0, 2, 4, 5, 6, 7, 9, 11) \
+  X("BebopDom 6", 0, 1, 2, 3, 5, 7, 8, 10) \
+  X("BebopDom 7", 0, 1, 2, 4, 6, 7, 9, 11) \
+  X("BebopDom 8", 0, 1, 3, 5, 6, 8, 10, 11) \
+  X("BebopMaj 2", 0, 2, 3, 5, 6, 7, 9, 10) \
+  X("BebopMaj 3", 0, 1, 3, 4, 5, 7, 8, 10) \
+  X("BebopMaj 4", 0, 2, 3, 4, 6, 7, 9, 11) \
+  X("BebopMaj 5", 0, 1, 2, 4, 5, 7, 9, 10) \
+  X("BebopMaj 6", 0, 1, 3, 4, 6, 8, 9, 11) \
+  X("BebopMaj 7", 0, 2, 3, 5, 7, 8, 10, 11) \
+  X("BebopMaj 8", 0, 1, 3, 5, 6, 8, 9, 10) \
+  X("BebopDor 2", 0, 1, 3, 5, 7, 8, 9, 10) \
+  X("BebopDor 3", 0, 2, 4, 6, 7, 8, 9, 11) \
+  X("BebopDor 4", 0, 2, 4, 5, 6, 7, 9, 10) \
+  X("BebopDor 5", 0, 2, 3, 4, 5, 7, 8, 10) \
+  X("BebopDor 6", 0, 1, 2, 3, 5, 6, 8, 10) \
+  X("BebopDor 7", 0, 1, 2, 4, 5, 7, 9, 11) \
+  X("BebopDor 8", 0, 1, 3, 4, 6, 8, 10, 11) \
+  X("Mess.4 2",   0, 1, 4, 5, 6, 7, 10, 11) \
+  X("Mess.4 3",   0, 3, 4, 5, 6, 9, 10, 11) \
+  X("Mess.4 4",   0, 1, 2, 3, 6, 7, 8, 9) \
+  X("Mess.6 2",   0, 2, 3, 4, 6, 8, 9, 10) \
+  X("Mess.6 3",   0, 1, 2, 4, 6, 7, 8, 10) \
+  X("Mess.6 4",   0, 1, 3, 5, 6, 7, 9, 11)
+
+#define SCALE_MASK_ENTRY(name, ...) scaleMask(__VA_ARGS__),
+#define SCALE_NAME_ENTRY(name, ...) name,
+
+const uint16_t scaleMasks[] PROGMEM = {
+  SCALE_LIBRARY(SCALE_MASK_ENTRY)
+};
+
+const char scaleNames[][11] PROGMEM = {
+  SCALE_LIBRARY(SCALE_NAME_ENTRY)
+};
+
+#undef SCALE_NAME_ENTRY
+#undef SCALE_MASK_ENTRY
+
+const uint8_t scaleCount = sizeof(scaleMasks) / sizeof(scaleMasks[0]);
+const uint8_t userScaleCount = 4;   // Per preset, numbered after the library
+
+static_assert(scaleCount + userScaleCount <= 255, "Scale numbers are 8-bit");
+static_assert(scaleRootNote + minSemitoneOffset >= 0, "minSemitoneOffset takes the root below MIDI 0");
+
+// Function declarations
+uint16_t scaleMaskOf(uint8_t scale);
+bool scaleAvailable(uint8_t scale);
+uint8_t nextScale(uint8_t scale);
+void expandScale(uint8_t scale);
+int scaleNote(uint8_t scale, int root, uint8_t button);
+// Note: userScaleMask() is defined in presets.h
+uint16_t userScaleMask(uint8_t slot);
+
+// Semitones above the root for each note button, from the expanded scale
+uint8_t scaleButtonIntervals[numNoteButtons];
+uint8_t expandedScale = 0xFF;
+
+uint16_t scaleMaskOf(uint8_t scale) {
+  if (scale < scaleCount) {
+    return pgm_read_word(&scaleMasks[scale]);
+  }
+  return userScaleMask(scale - scaleCount);
+}
+
+// Library scales always, user slots once they hold a scale
+bool scaleAvailable(uint8_t scale) {
+  return scale < scaleCount + userScaleCount && scaleMaskOf(scale) != 0;
+}
+
+uint8_t nextScale(uint8_t scale) {
+  do {
+    scale = (scale + 1) % (scaleCount + userScaleCount);
+  } while (!scaleAvailable(scale));
+  return scale;
+}
+
+// Degrees in mask order, continuing into the next octave until every
+// button has one
+void expandScale(uint8_t scale) {
+  uint16_t mask = scaleMaskOf(scale) | 1;   // The root is always in
+  uint8_t button = 0;
+
+  for (uint8_t octave = 0; button < numNoteButtons; octave++) {
+    for (uint8_t pitch = 0; pitch < 12 && button < numNoteButtons; pitch++) {
+      if (mask & (1 << pitch)) {
+        scaleButtonIntervals[button++] = octave * 12 + pitch;
+      }
+    }
+  }
+  expandedScale = scale;
+}
+
+// Sparse scales on a high root can run past MIDI 127; those notes fold
+// back down by octaves
+int scaleNote(uint8_t scale, int root, uint8_t button) {
+  if (scale != expandedScale) {
+    expandScale(scale);
+  }
+
+  int note = root + scaleButtonIntervals[button];
+  while (note > 127) {
+    note -= 12;
+  }
+  return note;
+}
+
+#endif // SCALES_H
@@ -0,0 +1,177 @@
+/*
+ * scanner.h - Timer-Driven Button Scanner
+ * 
+ * This file samples and debounces the buttons from a Timer1 compare
+ * interrupt at a fixed 1 kHz, independent of how long loop() takes. Every
+ * debounced press or release is timestamped and pushed into a lock-free
+ * single-producer/single-consumer queue that loop() drains. The delay from
+ * that scan to the resulting MIDI reaching USB is recorded as the latency
+ * telemetry stage.
+ * 
+ * Buttons on port B also scan from their pin-change interrupt, so with
+ * eager debounce a press is queued the moment it lands and wakes loop()
+ * from idle sleep (power.h) instead of waiting for the next tick.
+ */
+
+#ifndef SCANNER_H
+#define SCANNER_H
+
+// Press/release of one logical button, stamped with micros() at the scan
+struct ButtonEvent {
+  uint8_t button;
+  bool pressed;
+  unsigned long time;
+};
+
+// Function declarations
+void startButtonScanner();
+void scanButtonsTick();
+bool nextButtonEvent(ButtonEvent& event);
+bool buttonEventPending();
+void recordScanLatency();
+// Note: arpTimerTick() is defined in arpeggiator.h
+void arpTimerTick();
+// Note: looperTimerTick() is defined in looper.h
+void looperTimerTick();
+
+// Event queue: the ISR only writes buttonEventTail, loop() only writes
+// buttonEventHead, and 8-bit index accesses are atomic on AVR
+ButtonEvent buttonEvents[buttonEventQueueSize];
+volatile uint8_t buttonEventHead = 0;
+volatile uint8_t buttonEventTail = 0;
+volatile uint16_t buttonEventOverflows = 0;
+
+// Button state as seen by loop(), built up from the events it has consumed
+ButtonMask appliedButtons = 0;
+
+// Time from the scan that saw an edge to its MIDI leaving in flushMidiQueue()
+unsigned long scanLatencyStart = 0;
+bool scanLatencyPending = false;
+
+void startButtonScanner() {
+  // Timer1 in CTC mode: 16 MHz / 64 / 250 = 1 kHz
+  noInterrupts();
+  TCCR1A = 0;
+  TCCR1B = _BV(WGM12) | _BV(CS11) | _BV(CS10);
+  TCNT1 = 0;
+  OCR1A = 249;
+  TIMSK1 |= _BV(OCIE1A);
+
+  if (inputPinChangeMask != 0) {
+    PCMSK0 = inputPinChangeMask;
+    PCIFR = _BV(PCIF0);
+    PCICR |= _BV(PCIE0);
+  }
+  interrupts();
+}
+
+ISR(TIMER1_COMPA_vect) {
+  scanButtonsTick();
+  arpTimerTick();
+  looperTimerTick();
+}
+
+// Every contact edge of a port B button; the bounce that follows only
+// rescans, the debounce counters still run off the sample interval
+ISR(PCINT0_vect) {
+  scanButtonsTick();
+}
+
+// === SCAN (INTERRUPT CONTEXT) ===
+void scanButtonsTick() {
+  unsigned long now = micros();
+  ButtonMask before = debouncedButtons;
+
+  scanButtons();
+  debounceButtons(buttonSnapshot, millis());
+
+  ButtonMask changed = before ^ debouncedButtons;
+  if (changed == 0) {
+    recordStage(STAGE_SCAN, micros() - now);
+    return;
+  }
+
+  // Walk a single bit rather than shifting by i: wide masks have no
+  // variable shift instruction on AVR
+  ButtonMask bit = 1;
+  for (uint8_t i = 0; i < numButtons; i++, bit <<= 1) {
+    if (!(changed & bit)) {
+      continue;
+    }
+
+    uint8_t next = (buttonEventTail + 1) & (buttonEventQueueSize - 1);
+    if (next == buttonEventHead) {
+      // Full: loop() resynchronises from debouncedButtons once it catches up
+      buttonEventOverflows++;
+      return;
+    }
+
+    ButtonEvent& event = buttonEvents[buttonEventTail];
+    event.button = i;
+    event.pressed = (debouncedButtons & bit) != 0;
+    event.time = now;
+    buttonEventTail = next;
+  }
+
+  recordStage(STAGE_SCAN, micros() - now);
+}
+
+// === DRAIN (LOOP CONTEXT) ===
+// Events the scanner has queued that loop() hasn't taken yet
+bool buttonEventPending() {
+  return buttonEventHead != buttonEventTail;
+}
+
+bool nextButtonEvent(ButtonEvent& event) {
+  if (buttonEventHead != buttonEventTail) {
+    event = buttonEvents[buttonEventHead];
+    buttonEventHead = (buttonEventHead + 1) & (buttonEventQueueSize - 1);
+  } else {
+    // Queue empty: if events were lost, replay the difference to the
+    // current debounced state so no press or release goes missing
+    ButtonMask current;
+    noInterrupts();
+    current = debouncedButtons;
+    interrupts();
+
+    ButtonMask missed = current ^ appliedButtons;
+    if (missed == 0) {
+      return false;
+    }
+
+    uint8_t i = 0;
+    ButtonMask bit = 1;
+    while (!(missed & bit)) {
+      i++;
+      bit <<= 1;
+    }
+    event.button = i;
+    event.pressed = (current & bit) != 0;
+    event.time = micros();
+  }
+
+  if (event.pressed) {
+    appliedButtons |= (ButtonMask)1 << event.button;
+  } else {
+    appliedButtons &= ~((ButtonMask)1 << event.button);
+  }
+
+  // Oldest event whose MIDI has not gone out yet
+  if (!scanLatencyPending) {
+    scanLatencyStart = event.time;
+    scanLatencyPending = true;
+  }
+  return true;
+}
+
+// Called when MIDI reaches the USB endpoint
+void recordScanLatency() {
+  if (!scanLatencyPending) {
+    return;
+  }
+  scanLatencyPending = false;
+
+  recordStage(STAGE_LATENCY, micros() - scanLatencyStart);
+}
+
+#endif // SCANNER_H
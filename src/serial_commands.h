@@ -0,0 +1,421 @@
+/*
+ * serial_commands.h - Serial Command Processor
+ * 
+ * This file reads newline-terminated text commands from the USB serial
+ * port without blocking: each loop() pass consumes at most a few bytes
+ * into a fixed line buffer and runs a command once its line is complete.
+ * Commands and replies use the format midi-config.html speaks:
+ * 
+ *   SET_CHORD:<chord>,<pitch class>,...,<octave>  -> OK
+ *   GET_CHORDS                                    -> CHORD_DATA:<chord>,<pitch class>,...,<octave> x7
+ *   SET_STRUM:<ms>,<direction>                    -> OK (Chords mode strum, direction 0 up / 1 down)
+ *   SET_SCALE:<slot>,<pitch class>,...            -> OK (user scale; no pitch classes empties the slot)
+ *   GET_SCALES                                    -> SCALE_DATA:<slot>,<pitch class>,... x4
+ *   SCALE:<number>                                -> OK (select a scale; user slot n is 199 + n)
+ *   SCALE                                         -> SCALE:<number>
+ *   SAVE_CONFIG                                   -> OK (active preset queued for EEPROM)
+ *   PRESET:<bank>                                 -> OK (switch to preset bank)
+ *   PRESET                                        -> PRESET:<bank>
+ *   SET_LAYER:<layer>,<channel>,<transpose>,<first>,<last> -> OK
+ *   GET_LAYERS                                    -> LAYER_DATA:<layer>,<channel>,<transpose>,<first>,<last> x4
+ *   STATS / STATS_RESET                           -> see telemetry.h
+ * 
+ * Layer channels are 1-16, 0 turns the layer off; first and last are the
+ * logical buttons it covers (0-based, like the snapshot bits). Anything
+ * malformed is answered with ERROR:<reason>. No String objects
+ * or heap allocations are used.
+ */
+
+#ifndef SERIAL_COMMANDS_H
+#define SERIAL_COMMANDS_H
+
+// Function declarations
+void pollSerialCommands();
+void runSerialCommand(char* line);
+bool parseCommandNumber(const char*& cursor, int& value);
+void commandSetChord(const char* args);
+void commandGetChords();
+void commandSetStrum(const char* args);
+void commandSetScale(const char* args);
+void commandGetScales();
+void commandSelectScale(const char* args);
+void commandGetScale();
+void commandStats();
+void commandStatsReset();
+void commandSaveConfig();
+void commandSelectPreset(const char* args);
+void commandGetPreset();
+void commandSetLayer(const char* args);
+void commandGetLayers();
+void replySerialError(const __FlashStringHelper* reason);
+
+char serialLine[serialLineSize];
+uint8_t serialLineLength = 0;
+bool serialLineOverflow = false;   // Current line outgrew the buffer
+
+void pollSerialCommands() {
+  for (uint8_t i = 0; i < serialBytesPerPass && Serial.available() > 0; i++) {
+    char c = Serial.read();
+
+    if (c == '\n' || c == '\r') {
+      if (serialLineOverflow) {
+        replySerialError(F("LINE_TOO_LONG"));
+      } else if (serialLineLength > 0) {
+        serialLine[serialLineLength] = '\0';
+        runSerialCommand(serialLine);
+      }
+      serialLineLength = 0;
+      serialLineOverflow = false;
+    } else if (serialLineLength < serialLineSize - 1) {
+      serialLine[serialLineLength++] = c;
+    } else {
+      serialLineOverflow = true;
+    }
+  }
+}
+
+// === COMMAND DISPATCH ===
+void runSerialCommand(char* line) {
+  // Split "NAME:args" in place
+  char* args = strchr(line, ':');
+  if (args != NULL) {
+    *args++ = '\0';
+  }
+
+  if (strcmp_P(line, PSTR("SET_CHORD")) == 0 && args != NULL) {
+    commandSetChord(args);
+  } else if (strcmp_P(line, PSTR("SET_STRUM")) == 0 && args != NULL) {
+    commandSetStrum(args);
+  } else if (strcmp_P(line, PSTR("SET_SCALE")) == 0 && args != NULL) {
+    commandSetScale(args);
+  } else if (strcmp_P(line, PSTR("SCALE")) == 0 && args != NULL) {
+    commandSelectScale(args);
+  } else if (strcmp_P(line, PSTR("PRESET")) == 0 && args != NULL) {
+    commandSelectPreset(args);
+  } else if (strcmp_P(line, PSTR("SET_LAYER")) == 0 && args != NULL) {
+    commandSetLayer(args);
+  } else if (args != NULL) {
+    replySerialError(F("UNKNOWN_COMMAND"));
+  } else if (strcmp_P(line, PSTR("GET_CHORDS")) == 0) {
+    commandGetChords();
+  } else if (strcmp_P(line, PSTR("GET_SCALES")) == 0) {
+    commandGetScales();
+  } else if (strcmp_P(line, PSTR("SCALE")) == 0) {
+    commandGetScale();
+  } else if (strcmp_P(line, PSTR("SAVE_CONFIG")) == 0) {
+    commandSaveConfig();
+  } else if (strcmp_P(line, PSTR("PRESET")) == 0) {
+    commandGetPreset();
+  } else if (strcmp_P(line, PSTR("GET_LAYERS")) == 0) {
+    commandGetLayers();
+  } else if (strcmp_P(line, PSTR("STATS")) == 0) {
+    commandStats();
+  } else if (strcmp_P(line, PSTR("STATS_RESET")) == 0) {
+    commandStatsReset();
+  } else {
+    replySerialError(F("UNKNOWN_COMMAND"));
+  }
+}
+
+// Reads one comma-separated decimal field and steps past its comma.
+// Returns false at the end of the line or on anything but digits.
+bool parseCommandNumber(const char*& cursor, int& value) {
+  if (*cursor < '0' || *cursor > '9') {
+    return false;
+  }
+
+  value = 0;
+  while (*cursor >= '0' && *cursor <= '9') {
+    value = value * 10 + (*cursor++ - '0');
+    if (value > 255) {
+      return false;
+    }
+  }
+
+  if (*cursor == ',') {
+    cursor++;
+  } else if (*cursor != '\0') {
+    return false;
+  }
+  return true;
+}
+
+// === COMMANDS ===
+// SET_CHORD:<chord>,<pitch class>...,<octave>; the configurator sends an
+// empty pitch class list as "SET_CHORD:3,,4"
+void commandSetChord(const char* args) {
+  const char* cursor = args;
+  int fields[14];   // chord + up to 12 pitch classes + octave
+  uint8_t count = 0;
+
+  while (*cursor != '\0') {
+    if (*cursor == ',') {
+      cursor++;   // Empty field
+      continue;
+    }
+    if (count == 14 || !parseCommandNumber(cursor, fields[count])) {
+      replySerialError(F("BAD_ARGUMENT"));
+      return;
+    }
+    count++;
+  }
+
+  if (count < 2) {
+    replySerialError(F("BAD_ARGUMENT"));
+    return;
+  }
+
+  int chord = fields[0];
+  int octave = fields[count - 1];
+  if (chord >= numChords || octave < minChordOctave || octave > maxChordOctave) {
+    replySerialError(F("OUT_OF_RANGE"));
+    return;
+  }
+
+  uint16_t mask = 0;
+  for (uint8_t i = 1; i < count - 1; i++) {
+    if (fields[i] > 11) {
+      replySerialError(F("OUT_OF_RANGE"));
+      return;
+    }
+    mask |= 1 << fields[i];
+  }
+
+  activePreset->chordMasks[chord] = mask;
+  activePreset->chordOctaves[chord] = octave;
+  Serial.println(F("OK"));
+}
+
+// One CHORD_DATA line per chord, pitch classes in ascending order
+void commandGetChords() {
+  for (uint8_t chord = 0; chord < numChords; chord++) {
+    Serial.print(F("CHORD_DATA:"));
+    Serial.print(chord);
+    for (uint8_t pitch = 0; pitch < 12; pitch++) {
+      if (activePreset->chordMasks[chord] & (1 << pitch)) {
+        Serial.print(',');
+        Serial.print(pitch);
+      }
+    }
+    Serial.print(',');
+    Serial.println(activePreset->chordOctaves[chord]);
+  }
+}
+
+// SET_STRUM:<ms between notes>,<0 up, 1 down>; 0 ms plays chords at once
+void commandSetStrum(const char* args) {
+  int ms;
+  int down;
+  if (!parseCommandNumber(args, ms) || !parseCommandNumber(args, down) || *args != '\0') {
+    replySerialError(F("BAD_ARGUMENT"));
+    return;
+  }
+  if (ms > chordStrumMax || down > 1) {
+    replySerialError(F("OUT_OF_RANGE"));
+    return;
+  }
+
+  chordStrumMs = ms;
+  chordStrumDown = down;
+  markDisplayDirty(REGION_STATUS);
+  markDisplayDirty(REGION_DETAIL);
+  Serial.println(F("OK"));
+}
+
+// SET_SCALE:<user slot>,<pitch class>...; the root is always in, so
+// "SET_SCALE:0,0" plays only roots and "SET_SCALE:0" empties the slot
+void commandSetScale(const char* args) {
+  const char* cursor = args;
+  int fields[13];   // slot + up to 12 pitch classes
+  uint8_t count = 0;
+
+  while (*cursor != '\0') {
+    if (*cursor == ',') {
+      cursor++;   // Empty field
+      continue;
+    }
+    if (count == 13 || !parseCommandNumber(cursor, fields[count])) {
+      replySerialError(F("BAD_ARGUMENT"));
+      return;
+    }
+    count++;
+  }
+
+  if (count < 1) {
+    replySerialError(F("BAD_ARGUMENT"));
+    return;
+  }
+
+  int slot = fields[0];
+  if (slot >= userScaleCount) {
+    replySerialError(F("OUT_OF_RANGE"));
+    return;
+  }
+
+  uint16_t mask = 0;
+  for (uint8_t i = 1; i < count; i++) {
+    if (fields[i] > 11) {
+      replySerialError(F("OUT_OF_RANGE"));
+      return;
+    }
+    mask |= 1 << fields[i];
+  }
+
+  activePreset->userScales[slot] = mask;
+  if (currentScale == scaleCount + slot) {
+    if (mask == 0) {
+      currentScale = SCALE_MAJOR;
+    }
+    expandedScale = 0xFF;
+    markDisplayDirty(REGION_DETAIL);
+  }
+  Serial.println(F("OK"));
+}
+
+// One SCALE_DATA line per user slot, pitch classes in ascending order
+void commandGetScales() {
+  for (uint8_t slot = 0; slot < userScaleCount; slot++) {
+    Serial.print(F("SCALE_DATA:"));
+    Serial.print(slot);
+    for (uint8_t pitch = 0; pitch < 12; pitch++) {
+      if (activePreset->userScales[slot] & (1 << pitch)) {
+        Serial.print(',');
+        Serial.print(pitch);
+      }
+    }
+    Serial.println();
+  }
+}
+
+void commandSelectScale(const char* args) {
+  int scale;
+  if (!parseCommandNumber(args, scale) || *args != '\0') {
+    replySerialError(F("BAD_ARGUMENT"));
+    return;
+  }
+  if (!scaleAvailable(scale)) {
+    replySerialError(F("OUT_OF_RANGE"));
+    return;
+  }
+
+  currentScale = scale;
+  markDisplayDirty(REGION_DETAIL);
+  Serial.println(F("OK"));
+}
+
+void commandGetScale() {
+  Serial.print(F("SCALE:"));
+  Serial.println(currentScale);
+}
+
+void commandSaveConfig() {
+  // Written in the background by servicePresetStorage()
+  savePreset();
+  Serial.println(F("OK"));
+}
+
+void commandSelectPreset(const char* args) {
+  int bank;
+  if (!parseCommandNumber(args, bank) || *args != '\0') {
+    replySerialError(F("BAD_ARGUMENT"));
+    return;
+  }
+  if (bank >= presetBankCount) {
+    replySerialError(F("OUT_OF_RANGE"));
+    return;
+  }
+
+  stopAllPlayingNotes();
+  selectPreset(bank);
+  updateDisplay();
+  Serial.println(F("OK"));
+}
+
+void commandGetPreset() {
+  Serial.print(F("PRESET:"));
+  Serial.println(activeBank);
+}
+
+// SET_LAYER:<layer>,<channel>,<transpose>,<first button>,<last button>;
+// the transpose may be negative
+void commandSetLayer(const char* args) {
+  const char* cursor = args;
+  int layer, channel, transpose, first, last;
+  if (!parseCommandNumber(cursor, layer) || !parseCommandNumber(cursor, channel)) {
+    replySerialError(F("BAD_ARGUMENT"));
+    return;
+  }
+  bool negative = *cursor == '-';
+  if (negative) {
+    cursor++;
+  }
+  if (!parseCommandNumber(cursor, transpose) || !parseCommandNumber(cursor, first) ||
+      !parseCommandNumber(cursor, last) || *cursor != '\0') {
+    replySerialError(F("BAD_ARGUMENT"));
+    return;
+  }
+  if (negative) {
+    transpose = -transpose;
+  }
+
+  if (layer >= routeLayerCount || channel > 16 || transpose < -routeMaxTranspose ||
+      transpose > routeMaxTranspose || first > last || last >= numButtons) {
+    replySerialError(F("OUT_OF_RANGE"));
+    return;
+  }
+
+  RouteLayer settings;
+  settings.channel = channel == 0 ? noChannel : channel - 1;
+  settings.transpose = transpose;
+  settings.firstButton = first;
+  settings.lastButton = last;
+  setRouteLayer(layer, settings);
+  Serial.println(F("OK"));
+}
+
+void commandGetLayers() {
+  for (uint8_t layer = 0; layer < routeLayerCount; layer++) {
+    const RouteLayer& settings = routeLayers[layer];
+    Serial.print(F("LAYER_DATA:"));
+    Serial.print(layer);
+    Serial.print(',');
+    Serial.print(settings.channel == noChannel ? 0 : settings.channel + 1);
+    Serial.print(',');
+    Serial.print((int)settings.transpose);
+    Serial.print(',');
+    Serial.print(settings.firstButton);
+    Serial.print(',');
+    Serial.println(settings.lastButton);
+  }
+}
+
+void commandStats() {
+  printTelemetry();
+  Serial.print(F("STATS midi_queue depth="));
+  Serial.print(midiQueueDepth());
+  Serial.print(F(" high="));
+  Serial.print(midiQueueHighWater);
+  Serial.print(F(" overflows="));
+  Serial.println(midiQueueOverflows);
+  Serial.print(F("STATS button_queue overflows="));
+  Serial.println(buttonEventOverflows);
+  Serial.print(F("STATS arp clock="));
+  Serial.print(arpFollowingClock() ? F("midi") : F("internal"));
+  Serial.print(F(" bpm="));
+  Serial.print(arpBpm);
+  Serial.print(F(" overflows="));
+  Serial.println(arpStepOverflows);
+}
+
+void commandStatsReset() {
+  resetTelemetry();
+  midiQueueHighWater = midiQueueDepth();
+  Serial.println(F("OK"));
+}
+
+void replySerialError(const __FlashStringHelper* reason) {
+  Serial.print(F("ERROR:"));
+  Serial.println(reason);
+}
+
+#endif // SERIAL_COMMANDS_H
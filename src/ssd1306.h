@@ -0,0 +1,85 @@
+/*
+ * ssd1306.h - Minimal SSD1306 Driver
+ * 
+ * Just enough of the SSD1306 command set to run the 128x32 panel over I2C:
+ * the power-up sequence, an addressing window and a data stream. The panel
+ * holds the only copy of the frame; renderer.h produces the bytes as they
+ * are sent, so nothing is buffered here.
+ */
+
+#ifndef SSD1306_H
+#define SSD1306_H
+
+// Control byte sent after the address: Co = 0, D/C picks commands or data
+#define SSD1306_CONTROL_COMMANDS 0x00
+#define SSD1306_CONTROL_DATA 0x40
+
+#define SSD1306_COLUMNADDR 0x21
+#define SSD1306_PAGEADDR 0x22
+
+// Function declarations
+bool ssd1306Begin();
+void ssd1306Commands(const uint8_t* commands, uint8_t count);
+void ssd1306SetWindow(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn);
+void ssd1306Data(const uint8_t* data, uint8_t count);
+
+// Power-up sequence for a 128x32 panel on the internal charge pump; sent in
+// one transaction, so it must stay below the 32-byte Wire buffer
+const uint8_t ssd1306InitSequence[] PROGMEM = {
+  0xAE,                     // Display off
+  0xD5, 0x80,               // Clock divide ratio / oscillator frequency
+  0xA8, SCREEN_HEIGHT - 1,  // Multiplex ratio
+  0xD3, 0x00,               // No display offset
+  0x40,                     // Start line 0
+  0x8D, 0x14,               // Charge pump on
+  0x20, 0x00,               // Horizontal addressing: columns, then pages
+  0xA1,                     // Column 127 is SEG0
+  0xC8,                     // Scan COM outputs in reverse
+  0xDA, 0x02,               // COM pin layout for 32 rows
+  0x81, 0x8F,               // Contrast
+  0xD9, 0xF1,               // Pre-charge period
+  0xDB, 0x40,               // VCOMH deselect level
+  0xA4,                     // Show RAM contents
+  0xA6,                     // Not inverted
+  0x2E,                     // Scrolling off
+  0xAF                      // Display on
+};
+
+// Returns false if nothing acknowledges SCREEN_ADDRESS
+bool ssd1306Begin() {
+  Wire.begin();
+  Wire.setClock(displayI2CClock);
+
+  Wire.beginTransmission(SCREEN_ADDRESS);
+  Wire.write((uint8_t)SSD1306_CONTROL_COMMANDS);
+  for (uint8_t i = 0; i < sizeof(ssd1306InitSequence); i++) {
+    Wire.write(pgm_read_byte(&ssd1306InitSequence[i]));
+  }
+  return Wire.endTransmission() == 0;
+}
+
+void ssd1306Commands(const uint8_t* commands, uint8_t count) {
+  Wire.beginTransmission(SCREEN_ADDRESS);
+  Wire.write((uint8_t)SSD1306_CONTROL_COMMANDS);
+  Wire.write(commands, count);
+  Wire.endTransmission();
+}
+
+// Data written after this fills the window column by column, page by page
+void ssd1306SetWindow(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn) {
+  const uint8_t commands[] = {
+    SSD1306_PAGEADDR, firstPage, lastPage,
+    SSD1306_COLUMNADDR, firstColumn, lastColumn
+  };
+  ssd1306Commands(commands, sizeof(commands));
+}
+
+// At most 31 bytes per call (the Wire buffer, less the control byte)
+void ssd1306Data(const uint8_t* data, uint8_t count) {
+  Wire.beginTransmission(SCREEN_ADDRESS);
+  Wire.write((uint8_t)SSD1306_CONTROL_DATA);
+  Wire.write(data, count);
+  Wire.endTransmission();
+}
+
+#endif // SSD1306_H
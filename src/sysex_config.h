@@ -0,0 +1,296 @@
+/*
+ * sysex_config.h - SysEx Configuration Transport
+ * 
+ * This file lets a host read and write a whole preset in one SysEx
+ * exchange over USB MIDI, without the serial port. midi-config.html uses
+ * it through Web MIDI; any DAW that can send SysEx can too.
+ * 
+ * Message:  F0 7D 4D 43 <version> <command> <packed payload...> <checksum> F7
+ *   7D 4D 43   non-commercial manufacturer ID, then "MC"
+ *   version    sysexProtocolVersion
+ *   checksum   makes (version + command + packed payload + checksum) % 128 == 0
+ * 
+ * Payloads are 8-bit data packed into 7-bit bytes: each group of up to 7
+ * bytes is preceded by one byte holding their top bits (bit n = byte n).
+ * 
+ * Commands (host -> controller):
+ *   01 GET_CONFIG   <bank>                    -> 02 CONFIG_DATA <bank> <Preset>
+ *   03 SET_CONFIG   <bank> <flags> <Preset>   -> 7E ACK <command> <status>
+ *      flags bit 0: save the bank to EEPROM, bit 1: make it the active bank
+ *   04 GET_ACTIVE                             -> 05 ACTIVE_BANK <bank>
+ * Every rejected request is answered with ACK carrying a non-zero status.
+ * 
+ * <Preset> is the 43-byte struct from presets.h, multi-byte fields little
+ * endian: mode, scale, octaveOffset, semitoneOffset, drumNotes[10],
+ * chordMasks[7] (uint16), chordOctaves[7], userScales[4] (uint16). Its
+ * field offsets are part of the protocol: presets.h asserts them, and any
+ * change to the layout bumps sysexProtocolVersion.
+ */
+
+#ifndef SYSEX_CONFIG_H
+#define SYSEX_CONFIG_H
+
+const uint8_t sysexProtocolVersion = 2;
+
+// Commands
+const uint8_t SYSEX_GET_CONFIG = 0x01;
+const uint8_t SYSEX_CONFIG_DATA = 0x02;
+const uint8_t SYSEX_SET_CONFIG = 0x03;
+const uint8_t SYSEX_GET_ACTIVE = 0x04;
+const uint8_t SYSEX_ACTIVE_BANK = 0x05;
+const uint8_t SYSEX_ACK = 0x7E;
+
+// SET_CONFIG flags
+const uint8_t SYSEX_FLAG_SAVE = 0x01;
+const uint8_t SYSEX_FLAG_ACTIVATE = 0x02;
+
+// ACK status
+enum SysexStatus {
+  SYSEX_OK = 0,
+  SYSEX_BAD_CHECKSUM = 1,
+  SYSEX_BAD_LENGTH = 2,
+  SYSEX_BAD_BANK = 3,
+  SYSEX_UNKNOWN_COMMAND = 4,
+  SYSEX_BAD_VERSION = 5,
+  SYSEX_BAD_DATA = 6
+};
+
+const uint8_t sysexHeader[4] PROGMEM = {0xF0, 0x7D, 0x4D, 0x43};
+
+// Largest payload is SET_CONFIG: bank, flags and a Preset
+const uint8_t sysexMaxPayload = 2 + sizeof(Preset);
+const uint8_t sysexMaxPacked = sysexMaxPayload + (sysexMaxPayload + 6) / 7;
+const uint8_t sysexBufferSize = sizeof(sysexHeader) + 2 + sysexMaxPacked + 2;
+
+// Function declarations
+void receiveSysexPacket(midiEventPacket_t packet);
+void handleSysexMessage();
+void sendSysexMessage(uint8_t command, const uint8_t* payload, uint8_t length);
+void sendSysexAck(uint8_t command, uint8_t status);
+uint8_t packSysex7(const uint8_t* data, uint8_t length, uint8_t* packed);
+uint8_t unpackSysex7(const uint8_t* packed, uint8_t length, uint8_t* data);
+bool validPreset(const Preset& preset);
+
+// Incoming message being reassembled from USB-MIDI packets
+uint8_t sysexBuffer[sysexBufferSize];
+uint8_t sysexLength = 0;
+bool sysexOverflow = false;
+
+// === RECEIVE ===
+// USB-MIDI splits SysEx into 3-byte packets: CIN 4 = start/continue,
+// CIN 5/6/7 = end with 1/2/3 bytes
+void receiveSysexPacket(midiEventPacket_t packet) {
+  uint8_t cin = packet.header & 0x0F;
+  uint8_t bytes[3] = {packet.byte1, packet.byte2, packet.byte3};
+  uint8_t count = (cin == 0x4 || cin == 0x7) ? 3 : cin - 0x4;
+
+  if (bytes[0] == 0xF0) {
+    sysexLength = 0;
+    sysexOverflow = false;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    if (sysexLength < sysexBufferSize) {
+      sysexBuffer[sysexLength++] = bytes[i];
+    } else {
+      sysexOverflow = true;
+    }
+  }
+
+  if (cin != 0x4) {
+    // Messages for other devices, or too long for us, are ignored
+    if (!sysexOverflow) {
+      handleSysexMessage();
+    }
+    sysexLength = 0;
+  }
+}
+
+void handleSysexMessage() {
+  const uint8_t headerLength = sizeof(sysexHeader);
+
+  // Header, version, command, checksum and F7 at the very least
+  if (sysexLength < headerLength + 4 || sysexBuffer[sysexLength - 1] != 0xF7 ||
+      memcmp_P(sysexBuffer, sysexHeader, headerLength) != 0) {
+    return;
+  }
+
+  uint8_t command = sysexBuffer[headerLength + 1];
+  uint8_t sum = 0;
+  for (uint8_t i = headerLength; i < sysexLength - 1; i++) {
+    sum += sysexBuffer[i];
+  }
+
+  if (sysexBuffer[headerLength] != sysexProtocolVersion) {
+    sendSysexAck(command, SYSEX_BAD_VERSION);
+    return;
+  }
+  if ((sum & 0x7F) != 0) {
+    sendSysexAck(command, SYSEX_BAD_CHECKSUM);
+    return;
+  }
+
+  uint8_t payload[sysexMaxPayload];
+  uint8_t packedLength = sysexLength - headerLength - 4;
+  if (packedLength > sysexMaxPacked) {
+    sendSysexAck(command, SYSEX_BAD_LENGTH);
+    return;
+  }
+  uint8_t length = unpackSysex7(sysexBuffer + headerLength + 2, packedLength, payload);
+
+  if (command == SYSEX_GET_CONFIG) {
+    if (length != 1) {
+      sendSysexAck(command, SYSEX_BAD_LENGTH);
+      return;
+    }
+    uint8_t bank = payload[0];
+    if (bank >= presetBankCount) {
+      sendSysexAck(command, SYSEX_BAD_BANK);
+      return;
+    }
+
+    if (bank == activeBank) {
+      capturePreset();
+    } else {
+      loadPresetBank(bank);
+    }
+    payload[0] = bank;
+    memcpy(payload + 1, &presetBanks[bank], sizeof(Preset));
+    sendSysexMessage(SYSEX_CONFIG_DATA, payload, 1 + sizeof(Preset));
+
+  } else if (command == SYSEX_SET_CONFIG) {
+    if (length != 2 + sizeof(Preset)) {
+      sendSysexAck(command, SYSEX_BAD_LENGTH);
+      return;
+    }
+    uint8_t bank = payload[0];
+    uint8_t flags = payload[1];
+    const Preset& preset = *(const Preset*)(payload + 2);
+    if (bank >= presetBankCount) {
+      sendSysexAck(command, SYSEX_BAD_BANK);
+      return;
+    }
+    if (!validPreset(preset)) {
+      sendSysexAck(command, SYSEX_BAD_DATA);
+      return;
+    }
+
+    // Make sure the background loader won't overwrite what we store here
+    loadPresetBank(bank);
+    presetBanks[bank] = preset;
+
+    if (bank == activeBank || (flags & SYSEX_FLAG_ACTIVATE)) {
+      stopAllPlayingNotes();
+      if (bank == activeBank) {
+        applyPreset();
+      } else {
+        selectPreset(bank);
+      }
+      updateDisplay();
+    }
+    if (flags & SYSEX_FLAG_SAVE) {
+      presetSaveRequests |= (1 << bank);
+    }
+    sendSysexAck(command, SYSEX_OK);
+
+  } else if (command == SYSEX_GET_ACTIVE) {
+    if (length != 0) {
+      sendSysexAck(command, SYSEX_BAD_LENGTH);
+      return;
+    }
+    payload[0] = activeBank;
+    sendSysexMessage(SYSEX_ACTIVE_BANK, payload, 1);
+
+  } else {
+    sendSysexAck(command, SYSEX_UNKNOWN_COMMAND);
+  }
+}
+
+bool validPreset(const Preset& preset) {
+  for (uint8_t i = 0; i < 10; i++) {
+    if (preset.drumNotes[i] > 127) {
+      return false;
+    }
+  }
+  for (uint8_t i = 0; i < numChords; i++) {
+    if (preset.chordMasks[i] > chordMaskAll || preset.chordOctaves[i] > maxChordOctave) {
+      return false;
+    }
+  }
+  for (uint8_t i = 0; i < userScaleCount; i++) {
+    if (preset.userScales[i] > chordMaskAll) {
+      return false;
+    }
+  }
+  // Mode, scale and offsets are clamped by applyPreset()
+  return true;
+}
+
+// === SEND ===
+void sendSysexMessage(uint8_t command, const uint8_t* payload, uint8_t length) {
+  uint8_t message[sysexBufferSize];
+  uint8_t size = sizeof(sysexHeader);
+
+  memcpy_P(message, sysexHeader, size);
+  message[size++] = sysexProtocolVersion;
+  message[size++] = command;
+  size += packSysex7(payload, length, message + size);
+
+  uint8_t sum = 0;
+  for (uint8_t i = sizeof(sysexHeader); i < size; i++) {
+    sum += message[i];
+  }
+  message[size++] = (0x80 - (sum & 0x7F)) & 0x7F;
+  message[size++] = 0xF7;
+
+  // Three bytes per USB-MIDI packet; the last packet's CIN says how many
+  for (uint8_t i = 0; i < size; i += 3) {
+    uint8_t remaining = size - i;
+    midiEventPacket_t packet = {0x04, message[i], 0, 0};
+    if (remaining <= 3) {
+      packet.header = 0x04 + remaining;
+    }
+    if (remaining > 1) {
+      packet.byte2 = message[i + 1];
+    }
+    if (remaining > 2) {
+      packet.byte3 = message[i + 2];
+    }
+    queueMidiEvent(packet);
+  }
+}
+
+void sendSysexAck(uint8_t command, uint8_t status) {
+  uint8_t payload[2] = {(uint8_t)(command & 0x7F), status};
+  sendSysexMessage(SYSEX_ACK, payload, 2);
+}
+
+// === 7-BIT PACKING ===
+uint8_t packSysex7(const uint8_t* data, uint8_t length, uint8_t* packed) {
+  uint8_t size = 0;
+  for (uint8_t group = 0; group < length; group += 7) {
+    uint8_t msbIndex = size++;
+    packed[msbIndex] = 0;
+    for (uint8_t i = 0; i < 7 && group + i < length; i++) {
+      uint8_t value = data[group + i];
+      if (value & 0x80) {
+        packed[msbIndex] |= 1 << i;
+      }
+      packed[size++] = value & 0x7F;
+    }
+  }
+  return size;
+}
+
+uint8_t unpackSysex7(const uint8_t* packed, uint8_t length, uint8_t* data) {
+  uint8_t size = 0;
+  for (uint8_t group = 0; group < length; group += 8) {
+    uint8_t msbs = packed[group];
+    for (uint8_t i = 0; i < 7 && group + 1 + i < length; i++) {
+      data[size++] = packed[group + 1 + i] | ((msbs & (1 << i)) ? 0x80 : 0);
+    }
+  }
+  return size;
+}
+
+#endif // SYSEX_CONFIG_H
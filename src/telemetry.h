@@ -0,0 +1,167 @@
+/*
+ * telemetry.h - Hot-Path Timing Statistics
+ * 
+ * This file keeps always-on timing counters for the main firmware stages.
+ * Each stage tracks min/max/mean and a log2 histogram of its durations in
+ * microseconds, in fixed memory. The counters are dumped with the STATS
+ * serial command and cleared with STATS_RESET (serial_commands.h), along
+ * with the boot milestones used to check time-to-first-MIDI after power-on
+ * and the share of time spent in idle sleep, the stand-in for current draw.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+// Timed stages
+enum TelemetryStage {
+  STAGE_LOOP = 0,       // One loop() pass, excluding its idle sleep
+  STAGE_SCAN = 1,       // Button sampling and debounce in the timer ISR
+  STAGE_NOTE = 2,       // sendMidiNoteOn / sendMidiNoteOff
+  STAGE_USB = 3,        // flushMidiQueue handing packets to the endpoint
+  STAGE_RENDER = 4,     // Building and rendering one frame's display list
+  STAGE_I2C = 5,        // serviceDisplayFlush streaming to the panel
+  STAGE_LATENCY = 6,    // Scan that saw a button edge -> its MIDI sent to USB
+  STAGE_ARP = 7,        // Arpeggiator step falling due -> its note sent to USB
+  STAGE_ROUTE = 8,      // One note's fan-out over the routing layers
+  STAGE_SLEEP = 9,      // Idle sleep until the next interrupt (power.h)
+  STAGE_LOOPER = 10,    // Looper event falling due -> its note sent to USB
+  STAGE_STRUM = 11,     // Strummed chord note falling due -> sent to USB
+  STAGE_COUNT = 12
+};
+
+const char stageNames[STAGE_COUNT][8] PROGMEM = {
+  "loop", "scan", "note", "usb", "render", "i2c", "latency", "arp", "route", "sleep", "looper", "strum"
+};
+
+// Histogram bucket n counts durations below (8 << n) us; the last is open-ended
+const uint8_t telemetryBuckets = 8;
+
+struct StageStats {
+  uint16_t count;
+  uint16_t min;
+  uint16_t max;
+  uint32_t total;
+  uint16_t histogram[telemetryBuckets];
+};
+
+// Boot milestones in millis() since reset, 0 until reached
+unsigned long bootReadyTime = 0;       // setup() done: scanning and MIDI live
+unsigned long usbConfiguredTime = 0;   // Host finished enumerating the device
+unsigned long firstMidiTime = 0;       // First MIDI packet handed to USB
+
+// Time spent in idle sleep and awake since STATS_RESET, in us; both are
+// halved together before they overflow, which keeps their ratio
+uint32_t sleepMicros = 0;
+uint32_t awakeMicros = 0;
+unsigned long lastWakeTime = 0;
+
+// Function declarations
+void trackBootMilestones();
+void recordStage(uint8_t stage, unsigned long duration);
+void recordSleep(unsigned long start, unsigned long end);
+void resetTelemetry();
+void printTelemetry();
+
+StageStats stageStats[STAGE_COUNT];
+
+// Called every loop() pass; cheap once USB is configured
+void trackBootMilestones() {
+  if (usbConfiguredTime == 0 && USBDevice.configured()) {
+    usbConfiguredTime = millis();
+  }
+}
+
+void recordStage(uint8_t stage, unsigned long duration) {
+  StageStats& stats = stageStats[stage];
+  uint16_t value = duration > 0xFFFF ? 0xFFFF : duration;
+
+  if (stats.count == 0xFFFF) {
+    // Keep the mean meaningful on long runs by halving the running totals
+    stats.count >>= 1;
+    stats.total >>= 1;
+  }
+  if (stats.count == 0 || value < stats.min) {
+    stats.min = value;
+  }
+  if (value > stats.max) {
+    stats.max = value;
+  }
+  stats.count++;
+  stats.total += value;
+
+  uint8_t bucket = 0;
+  for (uint16_t v = value >> 3; v > 0 && bucket < telemetryBuckets - 1; v >>= 1) {
+    bucket++;
+  }
+  if (stats.histogram[bucket] < 0xFFFF) {
+    stats.histogram[bucket]++;
+  }
+}
+
+// Called by loop() with the times it went to sleep and woke up
+void recordSleep(unsigned long start, unsigned long end) {
+  awakeMicros += start - lastWakeTime;
+  sleepMicros += end - start;
+  lastWakeTime = end;
+
+  if ((sleepMicros | awakeMicros) & 0x80000000UL) {
+    sleepMicros >>= 1;
+    awakeMicros >>= 1;
+  }
+  recordStage(STAGE_SLEEP, end - start);
+}
+
+void resetTelemetry() {
+  // The scan stage is written from the timer interrupt
+  noInterrupts();
+  memset(stageStats, 0, sizeof(stageStats));
+  interrupts();
+
+  sleepMicros = 0;
+  awakeMicros = 0;
+  lastWakeTime = micros();
+}
+
+// One line per stage: STATS <stage> n=<count> min=<us> mean=<us> max=<us> hist=<b0>,...,<b7>
+void printTelemetry() {
+  for (uint8_t stage = 0; stage < STAGE_COUNT; stage++) {
+    StageStats stats;
+    noInterrupts();
+    stats = stageStats[stage];
+    interrupts();
+
+    Serial.print(F("STATS "));
+    Serial.print(FPSTR(stageNames[stage]));
+    Serial.print(F(" n="));
+    Serial.print(stats.count);
+    Serial.print(F(" min="));
+    Serial.print(stats.min);
+    Serial.print(F(" mean="));
+    Serial.print(stats.count ? stats.total / stats.count : 0);
+    Serial.print(F(" max="));
+    Serial.print(stats.max);
+    Serial.print(F(" hist="));
+    for (uint8_t i = 0; i < telemetryBuckets; i++) {
+      if (i > 0) {
+        Serial.print(',');
+      }
+      Serial.print(stats.histogram[i]);
+    }
+    Serial.println();
+  }
+
+  // STATS boot ready=<ms> usb=<ms> first_midi=<ms> (0 = not yet)
+  Serial.print(F("STATS boot ready="));
+  Serial.print(bootReadyTime);
+  Serial.print(F(" usb="));
+  Serial.print(usbConfiguredTime);
+  Serial.print(F(" first_midi="));
+  Serial.println(firstMidiTime);
+
+  // STATS power asleep=<per mille of the time since STATS_RESET>
+  uint32_t total = (sleepMicros >> 10) + (awakeMicros >> 10);
+  Serial.print(F("STATS power asleep="));
+  Serial.println(total ? (sleepMicros >> 10) * 1000 / total : 0);
+}
+
+#endif // TELEMETRY_H
@@ -0,0 +1,116 @@
+/*
+ * test_simulator.cpp - Trace Replay Tests
+ * 
+ * Replays every trace in test/traces through the firmware on the host
+ * (lib/simulator) and checks the MIDI it sends: the event stream must
+ * match the trace's golden file, no note may be left sounding, and
+ * note-on latency must stay within budget. Run with: pio test -e native
+ */
+
+#include <unity.h>
+#include <simulator.h>
+
+#ifndef SIM_TRACE_DIR
+#define SIM_TRACE_DIR "test/traces"
+#endif
+
+// First edge of a press to its note-on leaving for USB, in us
+const unsigned long noteOnLatencyBudget = 4000;
+
+// Release to note-off: the debounce window plus a scan
+const unsigned long noteOffLatencyBudget = 25000;
+
+SimResult replay(const char* name) {
+  std::string trace = std::string(SIM_TRACE_DIR "/") + name + ".trace";
+  std::string golden = std::string(SIM_TRACE_DIR "/") + name + ".golden";
+  std::string output = std::string("/tmp/midi-calc-") + name + ".out";
+
+  SimResult result;
+  std::vector<std::string> expected;
+  TEST_ASSERT_TRUE_MESSAGE(simRunTrace(trace.c_str(), output.c_str()), trace.c_str());
+  TEST_ASSERT_TRUE_MESSAGE(simLoadResult(output.c_str(), result), output.c_str());
+  TEST_ASSERT_TRUE_MESSAGE(simLoadGolden(golden.c_str(), expected), golden.c_str());
+
+  TEST_ASSERT_EQUAL_MESSAGE(expected.size(), result.events.size(), "Number of MIDI events");
+  for (size_t i = 0; i < expected.size(); i++) {
+    TEST_ASSERT_EQUAL_STRING(expected[i].c_str(), result.events[i].c_str());
+  }
+
+  TEST_ASSERT_EQUAL_MESSAGE(0, result.stuckNotes, "Notes left sounding");
+  TEST_ASSERT_LESS_OR_EQUAL(noteOnLatencyBudget, result.noteOnLatencyMax);
+  TEST_ASSERT_LESS_OR_EQUAL(noteOffLatencyBudget, result.noteOffLatencyMax);
+  return result;
+}
+
+// Contact bounce on press and release must not double-trigger
+void test_bounce_press() {
+  SimResult result = replay("bounce_press");
+  TEST_ASSERT_EQUAL(0, result.retriggers);
+}
+
+// E# and F share a pitch: the first release must not cut the other
+void test_shared_pitch() {
+  replay("shared_pitch");
+}
+
+// A mode change silences held notes; their release sends nothing more
+void test_mode_change() {
+  SimResult result = replay("mode_change");
+  TEST_ASSERT_EQUAL(0, result.retriggers);
+}
+
+void test_fast_chord() {
+  SimResult result = replay("fast_chord");
+  TEST_ASSERT_EQUAL(0, result.retriggers);
+}
+
+// A note released while mode is held as a shift still sends its note-off
+void test_mode_combo() {
+  replay("mode_combo");
+}
+
+// Sharp released in another mode's handler doesn't stay held
+void test_sharp_mode_change() {
+  replay("sharp_mode_change");
+}
+
+// Four routing layers: each press fans out to every layer covering it
+void test_layers() {
+  SimResult result = replay("layers");
+  TEST_ASSERT_EQUAL(0, result.retriggers);
+}
+
+// A recorded take loops, an overdub layer joins it and undo removes it
+void test_looper() {
+  SimResult result = replay("looper");
+  TEST_ASSERT_EQUAL(0, result.retriggers);
+}
+
+// Chords at once and strummed, two strums overlapping, and a release
+// mid-strum that drops the notes still to come
+void test_chords() {
+  SimResult result = replay("chords");
+  TEST_ASSERT_EQUAL(0, result.retriggers);
+}
+
+// Clock-synced arp: one step per six clocks, whether the timer's
+// prediction or the clock itself gets there first
+void test_arp_clock() {
+  SimResult result = replay("arp_clock");
+  TEST_ASSERT_EQUAL(0, result.retriggers);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_bounce_press);
+  RUN_TEST(test_shared_pitch);
+  RUN_TEST(test_mode_change);
+  RUN_TEST(test_fast_chord);
+  RUN_TEST(test_mode_combo);
+  RUN_TEST(test_sharp_mode_change);
+  RUN_TEST(test_layers);
+  RUN_TEST(test_looper);
+  RUN_TEST(test_chords);
+  RUN_TEST(test_arp_clock);
+  return UNITY_END();
+}